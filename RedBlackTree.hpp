@@ -4,12 +4,21 @@
 # include <memory>
 # include "iterator.hpp"
 # include "utility.hpp"
+# include "type_traits.hpp"
+# include "memory.hpp"
+# include "key_prefix.hpp"
 
 namespace ft {
+    struct node_emplace_tag {};
+
     template<class T>
     struct Node {
-        Node() { is_red = false; is_nil = true; }
+        Node() : is_red(false), is_nil(true), left(NULL), right(NULL), p(NULL) {}
         explicit Node(const T &key) : is_red(false), is_nil(false), key(key)  {}
+# if FT_CONTAINERS_CXX11
+        template<class... Args>
+        Node(node_emplace_tag, Args&&... args) : is_red(false), is_nil(false), key(std::forward<Args>(args)...)  {}
+# endif
         bool is_red;
         bool is_nil;
         T key;
@@ -24,6 +33,59 @@ namespace ft {
         }
     };
 
+    // A node that also keeps the prefix of its key, see key_prefix.hpp.
+    template<class T, class P>
+    struct PrefixNode: Node<T> {
+        PrefixNode() {}
+        explicit PrefixNode(const T &key) : Node<T>(key) {}
+# if FT_CONTAINERS_CXX11
+        template<class... Args>
+        PrefixNode(node_emplace_tag tag, Args&&... args) : Node<T>(tag, std::forward<Args>(args)...) {}
+# endif
+        P prefix;
+    };
+
+    // Compares a key being looked up with the keys of nodes, starting from
+    // the prefixes cached in them: -1 or 1 when the key is smaller or larger,
+    // 0 when it is equal. Without a Prefix policy the answer is always 0 and
+    // not exact, so Compare has the last word and the checks fold away.
+    template<class T, class Prefix, bool Enabled = Prefix::enabled>
+    class NodePrefixProbe {
+    public:
+        typedef Node<T> node_type;
+        static const bool exact = false;
+
+        explicit NodePrefixProbe(const T &) {}
+        int operator()(const Node<T> *) const { return 0; }
+        static void cache(Node<T> *) {}
+    };
+
+    template<class T, class Prefix>
+    class NodePrefixProbe<T, Prefix, true> {
+    public:
+        typedef typename Prefix::prefix_type prefix_type;
+        typedef PrefixNode<T, prefix_type> node_type;
+        static const bool exact = true;
+
+        explicit NodePrefixProbe(const T &key) : key(key), prefix(Prefix::prefix(key)) {}
+        int operator()(const Node<T> *x) const {
+            const prefix_type &other = static_cast<const node_type *>(x)->prefix;
+            if (prefix < other)
+                return -1;
+            if (other < prefix)
+                return 1;
+            int c = Prefix::compare(key, x->key);
+            return c < 0 ? -1 : c > 0 ? 1 : 0;
+        }
+        static void cache(Node<T> *x) {
+            static_cast<node_type *>(x)->prefix = Prefix::prefix(x->key);
+        }
+
+    private:
+        const T &key;
+        prefix_type prefix;
+    };
+
     template<class T>
     class tree_iterator {
     public:
@@ -202,7 +264,9 @@ namespace ft {
         node_ptr pos;
     };
 
-    template<class T, class Compare >
+    // With an enabled Prefix policy, nodes are PrefixNodes and descents
+    // compare cached prefixes before keys.
+    template<class T, class Compare, class Alloc = std::allocator<T>, class Prefix = no_key_prefix >
     class RedBlackTree {
 
     public:
@@ -211,12 +275,13 @@ namespace ft {
         typedef reverse_tree_iterator<iterator> reverse_iterator;
         typedef reverse_tree_iterator<const_iterator> const_reverse_iterator;
         typedef Node<T>* node_ptr;
+        typedef NodePrefixProbe<T, Prefix> prefix_probe;
+        typedef typename prefix_probe::node_type node_type;
+        typedef typename Alloc::template rebind<node_type>::other node_allocator;
 
-        RedBlackTree(Compare const & c): alloc(std::allocator<Node<T> >()), cmp(c) {
-            nil = alloc.allocate(1);
-            alloc.construct(nil, Node<T>());
+        explicit RedBlackTree(Compare const & c, Alloc const & a = Alloc()): alloc(a), cmp(c) {
+            nil = newNil();
             root = nil;
-            nil->p = nil;
             first = nil;
             last = nil;
             _size = 0;
@@ -226,8 +291,10 @@ namespace ft {
             if (other_root->is_nil)
                 new_root = nil;
             else {
-                new_root = alloc.allocate(1);
-                alloc.construct(new_root, Node<T>(other_root->key));
+                node_type *n = alloc.allocate(1);
+                alloc.construct(n, node_type(other_root->key));
+                new_root = n;
+                prefix_probe::cache(new_root);
                 new_root->is_red = other_root->is_red;
                 new_root->p = parent;
                 copyTree(new_root->left, new_root, other_root->left);
@@ -236,9 +303,7 @@ namespace ft {
         }
 
         RedBlackTree(const RedBlackTree& other): alloc(other.alloc), cmp(other.cmp) {
-            nil = alloc.allocate(1);
-            alloc.construct(nil, Node<T>());
-            nil->p = nil;
+            nil = newNil();
             root = nil;
             copyTree(root, nil, other.root);
             _size = other.size();
@@ -246,10 +311,22 @@ namespace ft {
             last = treeMaximum();
         }
 
-        RedBlackTree<T, Compare> & operator=(RedBlackTree<T, Compare> const & other) {
+# if FT_CONTAINERS_CXX11
+        RedBlackTree(RedBlackTree&& other): alloc(other.alloc), cmp(other.cmp) {
+            nil = newNil();
+            root = nil;
+            first = nil;
+            last = nil;
+            _size = 0;
+            swap(other);
+        }
+# endif
+
+        RedBlackTree & operator=(RedBlackTree const & other) {
             if (this != &other) {
                 clearTree(root);
                 copyTree(root, nil, other.root);
+                _size = other._size;
                 first = treeMinimum();
                 last = treeMaximum();
             }
@@ -258,13 +335,29 @@ namespace ft {
 
         ~RedBlackTree() {
             clearTree(root);
-            alloc.destroy(nil);
-            alloc.deallocate(nil, 1);
+            deleteNode(nil);
+        }
+
+        // The sentinel links to itself, so walks that reach it stay there,
+        // e.g. treeMinimum() on the empty tree left by erasing the last node.
+        Node<T> * newNil() {
+            node_type * ret = alloc.allocate(1);
+            alloc.construct(ret, node_type());
+            ret->left = ret;
+            ret->right = ret;
+            ret->p = ret;
+            return ret;
+        }
+
+        void deleteNode(Node<T> * x) {
+            alloc.destroy(static_cast<node_type *>(x));
+            alloc.deallocate(static_cast<node_type *>(x), 1);
         }
 
         Node<T> * newNode(const T & key) {
-            Node<T> * ret = alloc.allocate(1);
-            alloc.construct(ret, Node<T>(key));
+            node_type * ret = alloc.allocate(1);
+            alloc.construct(ret, node_type(key));
+            prefix_probe::cache(ret);
             ret->left = nil;
             ret->right = nil;
             ret->p = nil;
@@ -273,17 +366,38 @@ namespace ft {
             return ret;
         }
 
+# if FT_CONTAINERS_CXX11
+        template<class... Args>
+        Node<T> * emplaceNode(Args&&... args) {
+            node_type * ret = alloc.allocate(1);
+            try {
+                alloc.construct(ret, node_emplace_tag(), std::forward<Args>(args)...);
+            }
+            catch (...) {
+                alloc.deallocate(ret, 1);
+                throw;
+            }
+            prefix_probe::cache(ret);
+            ret->left = nil;
+            ret->right = nil;
+            ret->p = nil;
+            ret->is_red = true;
+            return ret;
+        }
+# endif
+
         void clearTree() {
             clearTree(root);
             root = nil;
+            first = nil;
+            last = nil;
         }
 
         void clearTree(Node<T> *x) {
             if (x != nil) {
                 clearTree(x->left);
                 Node<T> *right = x->right;
-                alloc.destroy(x);
-                alloc.deallocate(x, 1);
+                deleteNode(x);
                 clearTree(right);
                 --_size;
             }
@@ -306,12 +420,17 @@ namespace ft {
         }
 
         Node<T> *search(Node<T> *x, const T& k) const {
-            if (x == nil || (!cmp(k, x->key) && !cmp(x->key, k)))
-                return x;
-            if (cmp(k, x->key))
-                return search(x->left, k);
-            else
-                return search(x->right, k);
+            prefix_probe probe(k);
+            while (x != nil) {
+                int c = probe(x);
+                if (c < 0 || (c == 0 && !prefix_probe::exact && cmp(k, x->key)))
+                    x = x->left;
+                else if (c > 0 || (!prefix_probe::exact && cmp(x->key, k)))
+                    x = x->right;
+                else
+                    break;
+            }
+            return x;
         }
 
         Node<T> *iterSearch(const T& k) const {
@@ -357,10 +476,12 @@ namespace ft {
 
 
         iterator lower_bound(const T & key) {
+            prefix_probe probe(key);
             Node<T> *x = root;
             Node<T> *y = nil;
             while (!x->is_nil) {
-                if (cmp(x->key, key))
+                int c = probe(x);
+                if (c > 0 || (c == 0 && !prefix_probe::exact && cmp(x->key, key)))
                     x = x->right;
                 else {
                     y = x;
@@ -371,10 +492,12 @@ namespace ft {
         }
 
         const_iterator lower_bound(const T & key) const {
+            prefix_probe probe(key);
             Node<T> *x = root;
             Node<T> *y = nil;
             while (!x->is_nil) {
-                if (cmp(x->key, key))
+                int c = probe(x);
+                if (c > 0 || (c == 0 && !prefix_probe::exact && cmp(x->key, key)))
                     x = x->right;
                 else {
                     y = x;
@@ -385,10 +508,12 @@ namespace ft {
         }
 
         iterator upper_bound(const T & key) {
+            prefix_probe probe(key);
             Node<T> *x = root;
             Node<T> *y = nil;
             while (!x->is_nil) {
-                if (cmp(key, x->key)) {
+                int c = probe(x);
+                if (c < 0 || (c == 0 && !prefix_probe::exact && cmp(key, x->key))) {
                     y = x;
                     x = x->left;
                 }
@@ -399,10 +524,12 @@ namespace ft {
         }
 
         const_iterator upper_bound(const T & key) const {
+            prefix_probe probe(key);
             Node<T> *x = root;
             Node<T> *y = nil;
             while (!x->is_nil) {
-                if (cmp(key, x->key)) {
+                int c = probe(x);
+                if (c < 0 || (c == 0 && !prefix_probe::exact && cmp(key, x->key))) {
                     y = x;
                     x = x->left;
                 }
@@ -479,29 +606,42 @@ namespace ft {
         ft::pair<iterator, bool> rbInsert(const T& value) {
             Node<T> *new_node = newNode(value);
             ft::pair<iterator, bool> result = rbInsert(new_node);
-            if (!result.second) {
-                alloc.destroy(new_node);
-                alloc.deallocate(new_node, 1);
-            }
+            if (!result.second)
+                deleteNode(new_node);
             return result;
         }
 
+# if FT_CONTAINERS_CXX11
+        template<class... Args>
+        ft::pair<iterator, bool> rbEmplace(Args&&... args) {
+            Node<T> *new_node = emplaceNode(std::forward<Args>(args)...);
+            ft::pair<iterator, bool> result = rbInsert(new_node);
+            if (!result.second)
+                deleteNode(new_node);
+            return result;
+        }
+# endif
+
         ft::pair<iterator, bool> rbInsert(Node<T> *z) {
+            prefix_probe probe(z->key);
             Node<T> *x = root;
             Node<T> *y = nil;
+            bool left = false;
             while (x != nil) {
                 y = x;
-                if (cmp(z->key, x->key))
+                int c = probe(x);
+                left = c < 0 || (c == 0 && !prefix_probe::exact && cmp(z->key, x->key));
+                if (left)
                     x = x->left;
-                else if (!cmp(z->key, x->key) && !cmp(x->key, z->key))
-                    return ft::make_pair(iterator(x), false);
-                else
+                else if (c > 0 || (!prefix_probe::exact && cmp(x->key, z->key)))
                     x = x->right;
+                else
+                    return ft::make_pair(iterator(x), false);
             }
             z->p = y;
             if (y == nil)
                 root = z;
-            else if (cmp(z->key, y->key))
+            else if (left)
                 y->left = z;
             else
                 y->right = z;
@@ -513,23 +653,34 @@ namespace ft {
             return ft::make_pair(iterator(z), true);
         }
 
+        // The hint is taken when the value goes right before it, where the
+        // free slot is the left child of the hint or the right child of its
+        // predecessor; anything else is a plain insert.
         iterator rbInsert(iterator hint, const T& value) {
             Node<T> *node = hint.base();
-            Node<T> *z = newNode(value);
-            iterator res = iterator(z);
-            if (node->left == nil && cmp(value, node->key)) {
-                node->left = z;
-                ++_size;
-                insertFixUp(z);
+            Node<T> *parent;
+            if (_size == 0)
+                return rbInsert(value).first;
+            if (node == nil) {
+                if (!cmp(last->key, value))
+                    return rbInsert(value).first;
+                parent = last;
             }
-            else if (node->right == nil && cmp(node->key, value)) {
-                node->right = z;
-                ++_size;
-                insertFixUp(z);
+            else {
+                Node<T> *prev = node == first ? nil : treePredecessor(node);
+                if (!cmp(value, node->key) || (prev != nil && !cmp(prev->key, value)))
+                    return rbInsert(value).first;
+                parent = node->left == nil ? node : prev;
             }
+            Node<T> *z = newNode(value);
+            z->p = parent;
+            if (parent == node)
+                parent->left = z;
             else
-                res = rbInsert(z).first;
-            return res;
+                parent->right = z;
+            ++_size;
+            insertFixUp(z);
+            return iterator(z);
         }
 
         void insertFixUp(Node<T> *z) {
@@ -616,8 +767,7 @@ namespace ft {
                 deleteFixUp(x);
             first = treeMinimum();
             last = treeMaximum();
-            alloc.destroy(z);
-            alloc.deallocate(z, 1);
+            deleteNode(z);
         }
 
         void deleteFixUp(Node<T> *x) {
@@ -681,13 +831,23 @@ namespace ft {
             return alloc.max_size();
         }
 
+        // Links and colour bits of every node, plus the nil node shared by
+        // all leaves.
+        memory_footprint memory_usage() const {
+            memory_footprint usage;
+            usage.payload = _size * sizeof(T);
+            usage.node_overhead = _size * (sizeof(node_type) - sizeof(T));
+            usage.sentinel = sizeof(node_type);
+            return usage;
+        }
+
 
     private:
         Node<T> *root;
         Node<T> *nil;
         Node<T> *first;
         Node<T> *last;
-        std::allocator<Node<T> > alloc;
+        node_allocator alloc;
         Compare cmp;
         size_t _size;
     };
@@ -1,10 +1,65 @@
 #ifndef FT_CONTAINERS_ALGORITHM_HPP
 # define FT_CONTAINERS_ALGORITHM_HPP
+# include <cstddef>
+# include <cstring>
+# if defined(__AVX2__)
+#  include <immintrin.h>
+# elif defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+# include "type_traits.hpp"
 
 namespace ft {
+    // Pairs of pointers to the same integral type: their ranges compare equal
+    // exactly when their bytes do, so whole blocks can be compared at once.
+    template<class It1, class It2>
+    struct is_bitwise_comparable: false_type {};
+
+    template<class T>
+    struct is_bitwise_comparable<T*, T*>: integral_constant<bool, is_integral<typename remove_cv<T>::type>::value> {};
+    template<class T>
+    struct is_bitwise_comparable<const T*, T*>: integral_constant<bool, is_integral<typename remove_cv<T>::type>::value> {};
+    template<class T>
+    struct is_bitwise_comparable<T*, const T*>: integral_constant<bool, is_integral<typename remove_cv<T>::type>::value> {};
+
+    // Offset of the first byte at which a and b differ, or n. Uses the widest
+    // vector unit the target was compiled for, then 8-byte words.
+    inline size_t mismatch_bytes(const unsigned char* a, const unsigned char* b, size_t n) {
+        size_t i = 0;
+# if defined(__AVX2__)
+        for (; i + 32 <= n; i += 32) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+            if (mask != 0)
+                return i + __builtin_ctz(mask);
+        }
+# endif
+# if defined(__SSE2__)
+        for (; i + 16 <= n; i += 16) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFFu;
+            if (mask != 0)
+                return i + __builtin_ctz(mask);
+        }
+# endif
+        for (; i + 8 <= n; i += 8) {
+            unsigned long long x, y;
+            std::memcpy(&x, a + i, 8);
+            std::memcpy(&y, b + i, 8);
+            if (x != y)
+                break;
+        }
+        for (; i < n; ++i)
+            if (a[i] != b[i])
+                return i;
+        return n;
+    }
+
     template<class InputIt1, class InputIt2>
-    bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
-                                 InputIt2 first2, InputIt2 last2) {
+    bool _lexicographical_compare(InputIt1 first1, InputIt1 last1,
+                                  InputIt2 first2, InputIt2 last2, false_type) {
         for (; (first1 != last1) && (first2 != last2); ++first1, (void) ++first2) {
             if (*first1 < *first2) return true;
             if (*first2 < *first1) return false;
@@ -12,6 +67,32 @@ namespace ft {
         return (first1 == last1) && (first2 != last2);
     }
 
+    // Finds the first differing byte, then orders by the element holding it,
+    // which keeps signed and multi-byte types correct.
+    template<class T>
+    bool _lexicographical_compare(const T* first1, const T* last1,
+                                  const T* first2, const T* last2, true_type) {
+        size_t n1 = last1 - first1;
+        size_t n2 = last2 - first2;
+        size_t n = n1 < n2 ? n1 : n2;
+        if (n != 0) {
+            size_t off = mismatch_bytes(reinterpret_cast<const unsigned char*>(first1),
+                                        reinterpret_cast<const unsigned char*>(first2), n * sizeof(T));
+            if (off != n * sizeof(T)) {
+                size_t i = off / sizeof(T);
+                return first1[i] < first2[i];
+            }
+        }
+        return n1 < n2;
+    }
+
+    template<class InputIt1, class InputIt2>
+    bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
+                                 InputIt2 first2, InputIt2 last2) {
+        return _lexicographical_compare(first1, last1, first2, last2,
+                integral_constant<bool, is_bitwise_comparable<InputIt1, InputIt2>::value>());
+    }
+
     template<class InputIt1, class InputIt2, class Compare>
     bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
                                  InputIt2 first2, InputIt2 last2,
@@ -24,8 +105,8 @@ namespace ft {
     }
 
     template<class InputIt1, class InputIt2>
-    bool equal(InputIt1 first1, InputIt1 last1,
-               InputIt2 first2) {
+    bool _equal(InputIt1 first1, InputIt1 last1,
+                InputIt2 first2, false_type) {
         for (; first1 != last1; ++first1, ++first2) {
             if (*first1 != *first2) {
                 return false;
@@ -34,6 +115,21 @@ namespace ft {
         return true;
     }
 
+    template<class T>
+    bool _equal(const T* first1, const T* last1,
+                const T* first2, true_type) {
+        if (first1 == last1)
+            return true;
+        return std::memcmp(first1, first2, (last1 - first1) * sizeof(T)) == 0;
+    }
+
+    template<class InputIt1, class InputIt2>
+    bool equal(InputIt1 first1, InputIt1 last1,
+               InputIt2 first2) {
+        return _equal(first1, last1, first2,
+                integral_constant<bool, is_bitwise_comparable<InputIt1, InputIt2>::value>());
+    }
+
     template<class InputIt1, class InputIt2, class BinaryPredicate>
     bool equal(InputIt1 first1, InputIt1 last1,
                InputIt2 first2, BinaryPredicate p) {
@@ -44,5 +140,22 @@ namespace ft {
         }
         return true;
     }
+
+    // Moves the elements for which p is false to the front, keeping their
+    // order, in a single pass; returns the new logical end.
+    template<class ForwardIt, class UnaryPredicate>
+    ForwardIt remove_if(ForwardIt first, ForwardIt last, UnaryPredicate p) {
+        for (; first != last && !p(*first); ++first)
+            ;
+        if (first == last)
+            return first;
+        ForwardIt out = first;
+        for (++first; first != last; ++first)
+            if (!p(*first)) {
+                *out = FT_MOVE(*first);
+                ++out;
+            }
+        return out;
+    }
 }
 #endif//FT_CONTAINERS_ALGORITHM_HPP
@@ -0,0 +1,149 @@
+// What ft::aligned_allocator and ft::hugepage_allocator buy an ft::vector.
+//
+// Vectorization: y = a * x + y over floats that stay in L1, so the loop is
+// bound by its loads and stores. With aligned_allocator<float, 64> the
+// kernel can promise the compiler 64-byte alignment; std::allocator data is
+// only 16-byte aligned, and the same data shifted by one float puts every
+// other vector load across a cache line.
+//
+// TLB: random reads from a table much larger than the TLB reach with 4 KiB
+// pages. hugepage_allocator maps it on 2 MiB boundaries with MADV_HUGEPAGE;
+// the baseline is std::allocator with the table marked MADV_NOHUGEPAGE, as
+// with transparent huge pages set to "always" malloc memory may get huge
+// pages too, which is shown as a third row. The kB column is the growth of
+// AnonHugePages in /proc/self/smaps_rollup, i.e. what THP really backed.
+//
+// Build and run from the repository root, with -march=native to let the
+// compiler use the widest vectors the machine has:
+//
+//     c++ -O3 -march=native -I. bench/allocator_bench.cpp -o allocator_bench
+//     ./allocator_bench [table MiB, default 512] [random reads, default 20000000]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <time.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include "vector.hpp"
+#include "memory.hpp"
+
+namespace {
+    const size_t kernel_floats = 4096;
+    const int kernel_repeats = 20000;
+
+    double seconds() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+    }
+
+    // AnonHugePages of the whole process in kB, or -1 if the kernel does
+    // not report it.
+    long huge_page_kb() {
+        FILE* f = std::fopen("/proc/self/smaps_rollup", "r");
+        if (f == NULL)
+            return -1;
+        char line[256];
+        long kb = -1;
+        while (std::fgets(line, sizeof(line), f) != NULL)
+            if (std::sscanf(line, "AnonHugePages: %ld kB", &kb) == 1)
+                break;
+        std::fclose(f);
+        return kb;
+    }
+
+    float sink = 0;
+
+    __attribute__((noinline)) void saxpy( float a, const float* x, float* y, size_t n ) {
+        for (size_t i = 0; i < n; ++i)
+            y[i] = a * x[i] + y[i];
+    }
+
+    __attribute__((noinline)) void saxpy_aligned( float a, const float* x, float* y, size_t n ) {
+        const float* ax = static_cast<const float*>(__builtin_assume_aligned(x, 64));
+        float* ay = static_cast<float*>(__builtin_assume_aligned(y, 64));
+        for (size_t i = 0; i < n; ++i)
+            ay[i] = a * ax[i] + ay[i];
+    }
+
+    // Nanoseconds per element.
+    double time_saxpy( void (*kernel)( float, const float*, float*, size_t ), const float* x, float* y ) {
+        double best = 0;
+        for (int run = 0; run < 5; ++run) {
+            double begin = seconds();
+            for (int r = 0; r < kernel_repeats; ++r)
+                kernel(1.0001f, x, y, kernel_floats);
+            double elapsed = seconds() - begin;
+            if (run == 0 || elapsed < best)
+                best = elapsed;
+        }
+        sink += y[kernel_floats / 2];
+        return best * 1e9 / (double(kernel_repeats) * kernel_floats);
+    }
+
+    template<class Alloc>
+    void saxpy_row( const char* name, size_t offset, bool aligned ) {
+        ft::vector<float, Alloc> x(kernel_floats + offset, 1.0f), y(kernel_floats + offset, 2.0f);
+        const float* px = x.data() + offset;
+        float* py = y.data() + offset;
+        double ns = time_saxpy(aligned ? saxpy_aligned : saxpy, px, py);
+        std::printf("%-34s %8lu %12.3f\n", name, static_cast<unsigned long>(reinterpret_cast<uintptr_t>(px) % 64), ns);
+    }
+
+    uint64_t xorshift( uint64_t& state ) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Nanoseconds per random read. The table size is a power of two.
+    template<class Alloc>
+    void tlb_row( const char* name, size_t entries, size_t reads, int huge_advice ) {
+        long before = huge_page_kb();
+        ft::vector<uint64_t, Alloc> table;
+        table.reserve(entries);
+        if (huge_advice >= 0) {
+            size_t page = 4096;
+            uintptr_t first = (reinterpret_cast<uintptr_t>(table.data()) + page - 1) / page * page;
+            uintptr_t last = reinterpret_cast<uintptr_t>(table.data() + entries) / page * page;
+            if (last > first)
+                madvise(reinterpret_cast<void*>(first), last - first, huge_advice);
+        }
+        table.resize(entries);
+        for (size_t i = 0; i < entries; ++i)
+            table[i] = i;
+        long after = huge_page_kb();
+        uint64_t state = 88172645463325252ULL, sum = 0, mask = entries - 1;
+        double begin = seconds();
+        for (size_t i = 0; i < reads; ++i)
+            sum += table[xorshift(state) & mask];
+        double elapsed = seconds() - begin;
+        sink += static_cast<float>(sum & 1);
+        std::printf("%-34s %12ld %12.2f\n", name, before < 0 ? -1 : after - before, elapsed * 1e9 / reads);
+    }
+}
+
+int main( int argc, char** argv ) {
+    size_t mib = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 512;
+    size_t reads = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 20000000;
+    size_t entries = 1;
+    while (entries * 2 * sizeof(uint64_t) <= mib << 20)
+        entries *= 2;
+    if (mib == 0 || reads == 0) {
+        std::fprintf(stderr, "need a table of at least 1 MiB and at least one read\n");
+        return 1;
+    }
+
+    std::printf("%-34s %8s %12s\n", "saxpy over 4096 floats", "addr%64", "ns/element");
+    saxpy_row<ft::aligned_allocator<float, 64> >("aligned_allocator<float, 64>", 0, true);
+    saxpy_row<std::allocator<float> >("std::allocator", 0, false);
+    saxpy_row<std::allocator<float> >("std::allocator, one float off", 1, false);
+
+    std::printf("\n%-34s %12s %12s\n", "random reads, table of 2^k words", "huge kB", "ns/read");
+    tlb_row<std::allocator<uint64_t> >("std::allocator, MADV_NOHUGEPAGE", entries, reads, MADV_NOHUGEPAGE);
+    tlb_row<std::allocator<uint64_t> >("std::allocator", entries, reads, -1);
+    tlb_row<ft::hugepage_allocator<uint64_t> >("hugepage_allocator", entries, reads, -1);
+    return sink == 12345.0f ? 2 : 0;
+}
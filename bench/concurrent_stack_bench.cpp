@@ -0,0 +1,148 @@
+// Push/pop throughput of ft::concurrent_stack against an ft::stack behind a
+// pthread mutex, at 1, 2, 4, ... up to 64 threads. Every thread pushes a
+// burst of up to 8 elements and pops as many, so the stack stays near the
+// top of its pool and the threads meet on the head word, where the
+// elimination array is meant to help. Build and run from the repository root:
+//
+//     c++ -O2 -pthread -I. bench/concurrent_stack_bench.cpp -o concurrent_stack_bench
+//     ./concurrent_stack_bench [operations per thread, default 1000000] [most threads, default 64]
+//
+// A pop that finds the stack empty is retried; the element counts are
+// checked at the end, so a lost or duplicated element fails the run.
+#include <cstdio>
+#include <cstdlib>
+#include <pthread.h>
+#include <time.h>
+#include <stdint.h>
+#include "concurrent_stack.hpp"
+#include "stack.hpp"
+
+namespace {
+    const int max_threads = 64;
+
+    double seconds() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+    }
+
+    class locked_stack {
+    public:
+        locked_stack() { pthread_mutex_init(&_lock, NULL); }
+        ~locked_stack() { pthread_mutex_destroy(&_lock); }
+
+        void push( long value ) {
+            pthread_mutex_lock(&_lock);
+            _stack.push(value);
+            pthread_mutex_unlock(&_lock);
+        }
+
+        bool try_pop( long& out ) {
+            pthread_mutex_lock(&_lock);
+            bool found = !_stack.empty();
+            if (found) {
+                out = _stack.top();
+                _stack.pop();
+            }
+            pthread_mutex_unlock(&_lock);
+            return found;
+        }
+
+    private:
+        pthread_mutex_t _lock;
+        ft::stack<long> _stack;
+    };
+
+    template< class Stack >
+    struct worker {
+        Stack* stack;
+        pthread_barrier_t* start;
+        long operations;
+        long id;
+        long popped_sum;
+        long pushed_sum;
+        double began;
+        double finished;
+    };
+
+    template< class Stack >
+    void* run( void* arg ) {
+        worker<Stack>& w = *static_cast<worker<Stack>*>(arg);
+        unsigned seed = static_cast<unsigned>(w.id) * 2654435761u + 1;
+        pthread_barrier_wait(w.start);
+        w.began = seconds();
+        for (long done = 0; done < w.operations; ) {
+            seed = seed * 1103515245u + 12345u;
+            long burst = 1 + (seed >> 16) % 8;
+            for (long i = 0; i < burst; ++i) {
+                long value = w.id << 32 | (done + i);
+                w.stack->push(value);
+                w.pushed_sum += value;
+            }
+            for (long i = 0; i < burst; ++i) {
+                long value;
+                while (!w.stack->try_pop(value))
+                    ;
+                w.popped_sum += value;
+            }
+            done += 2 * burst;
+        }
+        w.finished = seconds();
+        return NULL;
+    }
+
+    // Operations per second over all threads, from the first one starting
+    // to the last one finishing. The threads take their own times, since
+    // with more threads than cores the main thread may only run again once
+    // they are done.
+    template< class Stack >
+    double measure( int threads, long operations ) {
+        Stack stack;
+        pthread_barrier_t start;
+        pthread_barrier_init(&start, NULL, threads + 1);
+        worker<Stack> workers[max_threads];
+        pthread_t ids[max_threads];
+        for (int t = 0; t < threads; ++t) {
+            worker<Stack> w = { &stack, &start, operations, t, 0, 0, 0, 0 };
+            workers[t] = w;
+            pthread_create(&ids[t], NULL, run<Stack>, &workers[t]);
+        }
+        pthread_barrier_wait(&start);
+        long pushed = 0, popped = 0, total = 0;
+        double began = 0, finished = 0;
+        for (int t = 0; t < threads; ++t) {
+            pthread_join(ids[t], NULL);
+            pushed += workers[t].pushed_sum;
+            popped += workers[t].popped_sum;
+            if (t == 0 || workers[t].began < began)
+                began = workers[t].began;
+            if (workers[t].finished > finished)
+                finished = workers[t].finished;
+        }
+        pthread_barrier_destroy(&start);
+        long rest;
+        if (pushed != popped || stack.try_pop(rest)) {
+            std::fprintf(stderr, "element checksum mismatch at %d threads\n", threads);
+            std::exit(1);
+        }
+        for (int t = 0; t < threads; ++t)
+            total += workers[t].operations;
+        return total / (finished - began);
+    }
+}
+
+int main( int argc, char** argv ) {
+    long operations = argc > 1 ? std::atol(argv[1]) : 1000000;
+    int most = argc > 2 ? std::atoi(argv[2]) : max_threads;
+    if (most < 1 || most > max_threads) {
+        std::fprintf(stderr, "thread count must be between 1 and %d\n", max_threads);
+        return 1;
+    }
+    std::printf("%-8s %18s %18s %8s\n", "threads", "concurrent Mops/s", "mutex Mops/s", "ratio");
+    for (int threads = 1; threads <= most; threads *= 2) {
+        double lock_free = measure<ft::concurrent_stack<long> >(threads, operations);
+        double locked = measure<locked_stack>(threads, operations);
+        std::printf("%-8d %18.2f %18.2f %8.2f\n", threads, lock_free / 1e6, locked / 1e6, lock_free / locked);
+    }
+    return 0;
+}
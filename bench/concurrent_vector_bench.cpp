@@ -0,0 +1,166 @@
+// Producer scaling of ft::concurrent_vector against an ft::vector behind a
+// pthread mutex, the setup concurrent_vector is meant to replace. Each of
+// 1, 2, 4, ... producer threads appends its share of the elements, either
+// one push_back at a time or in grow_by batches; the locked vector appends
+// a batch under one lock. Build and run from the repository root:
+//
+//     c++ -O2 -pthread -I. bench/concurrent_vector_bench.cpp -o concurrent_vector_bench
+//     ./concurrent_vector_bench [elements per thread, default 1000000] [most threads, default 64]
+//
+// The elements are checked afterwards: every producer's values must all be
+// there, in order among themselves.
+#include <cstdio>
+#include <cstdlib>
+#include <pthread.h>
+#include <time.h>
+#include <stdint.h>
+#include "concurrent_vector.hpp"
+#include "vector.hpp"
+
+namespace {
+    const int max_threads = 64;
+    const long batch = 64;
+    const int producer_shift = 40;
+
+    double seconds() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+    }
+
+    class locked_vector {
+    public:
+        locked_vector() { pthread_mutex_init(&_lock, NULL); }
+        ~locked_vector() { pthread_mutex_destroy(&_lock); }
+
+        void push_back( uint64_t value ) {
+            pthread_mutex_lock(&_lock);
+            _vector.push_back(value);
+            pthread_mutex_unlock(&_lock);
+        }
+
+        void grow_by( const uint64_t* first, const uint64_t* last ) {
+            pthread_mutex_lock(&_lock);
+            _vector.insert(_vector.end(), first, last);
+            pthread_mutex_unlock(&_lock);
+        }
+
+        size_t size() const { return _vector.size(); }
+        uint64_t operator[]( size_t pos ) const { return _vector[pos]; }
+
+    private:
+        pthread_mutex_t _lock;
+        ft::vector<uint64_t> _vector;
+    };
+
+    struct concurrent {
+        ft::concurrent_vector<uint64_t> vector;
+
+        void push_back( uint64_t value ) { vector.push_back(value); }
+        void grow_by( const uint64_t* first, const uint64_t* last ) { vector.grow_by(first, last); }
+        size_t size() const { return vector.size(); }
+        uint64_t operator[]( size_t pos ) const { return vector[pos]; }
+    };
+
+    template< class Vector >
+    struct producer {
+        Vector* vector;
+        pthread_barrier_t* start;
+        long elements;
+        int id;
+        bool batched;
+        double began;
+        double finished;
+    };
+
+    template< class Vector >
+    void* produce( void* arg ) {
+        producer<Vector>& p = *static_cast<producer<Vector>*>(arg);
+        uint64_t base = uint64_t(p.id) << producer_shift;
+        pthread_barrier_wait(p.start);
+        p.began = seconds();
+        if (!p.batched) {
+            for (long i = 0; i < p.elements; ++i)
+                p.vector->push_back(base | i);
+            p.finished = seconds();
+            return NULL;
+        }
+        uint64_t values[batch];
+        for (long i = 0; i < p.elements; ) {
+            long n = 0;
+            for (; n < batch && i + n < p.elements; ++n)
+                values[n] = base | (i + n);
+            p.vector->grow_by(values, values + n);
+            i += n;
+        }
+        p.finished = seconds();
+        return NULL;
+    }
+
+    template< class Vector >
+    void check( const Vector& vector, int threads, long elements ) {
+        long next[max_threads] = { 0 };
+        bool ok = vector.size() == size_t(threads) * elements;
+        for (size_t i = 0; ok && i < vector.size(); ++i) {
+            uint64_t value = vector[i];
+            uint64_t id = value >> producer_shift;
+            ok = id < uint64_t(threads) && (value & ((uint64_t(1) << producer_shift) - 1)) == uint64_t(next[id]);
+            if (ok)
+                ++next[id];
+        }
+        if (!ok) {
+            std::fprintf(stderr, "elements lost or out of order at %d threads\n", threads);
+            std::exit(1);
+        }
+    }
+
+    // Appended elements per second over all threads, from the first thread
+    // starting to the last one finishing. The threads take their own times:
+    // on a machine with fewer cores than threads, the main thread may only
+    // run again once they are done.
+    template< class Vector >
+    double measure( int threads, long elements, bool batched ) {
+        Vector vector;
+        pthread_barrier_t start;
+        pthread_barrier_init(&start, NULL, threads + 1);
+        producer<Vector> producers[max_threads];
+        pthread_t ids[max_threads];
+        for (int t = 0; t < threads; ++t) {
+            producer<Vector> p = { &vector, &start, elements, t, batched, 0, 0 };
+            producers[t] = p;
+            pthread_create(&ids[t], NULL, produce<Vector>, &producers[t]);
+        }
+        pthread_barrier_wait(&start);
+        double began = 0, finished = 0;
+        for (int t = 0; t < threads; ++t) {
+            pthread_join(ids[t], NULL);
+            if (t == 0 || producers[t].began < began)
+                began = producers[t].began;
+            if (producers[t].finished > finished)
+                finished = producers[t].finished;
+        }
+        pthread_barrier_destroy(&start);
+        check(vector, threads, elements);
+        return threads * elements / (finished - began);
+    }
+}
+
+int main( int argc, char** argv ) {
+    long elements = argc > 1 ? std::atol(argv[1]) : 1000000;
+    int most = argc > 2 ? std::atoi(argv[2]) : max_threads;
+    if (elements < 1 || most < 1 || most > max_threads) {
+        std::fprintf(stderr, "need at least one element and between 1 and %d threads\n", max_threads);
+        return 1;
+    }
+    std::printf("%-8s %14s %14s %14s %14s   (M elements/s)\n", "threads",
+                "push_back", "locked push", "grow_by", "locked batch");
+    for (int threads = 1; threads <= most; threads *= 2) {
+        double push = measure<concurrent>(threads, elements, false);
+        double locked_push = measure<locked_vector>(threads, elements, false);
+        double grow = measure<concurrent>(threads, elements, true);
+        double locked_grow = measure<locked_vector>(threads, elements, true);
+        std::printf("%-8d %14.2f %14.2f %14.2f %14.2f\n", threads,
+                    push / 1e6, locked_push / 1e6, grow / 1e6, locked_grow / 1e6);
+    }
+    return 0;
+}
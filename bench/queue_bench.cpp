@@ -0,0 +1,258 @@
+// Throughput and latency of ft::spsc_ring and ft::mpmc_queue, with an
+// ft::queue behind a pthread mutex as the baseline. Producers stamp every
+// item with ft::latency_clock and consumers record how long it sat in the
+// queue, so the latency columns include queueing delay while the queue is
+// full. Build and run from the repository root:
+//
+//     c++ -O2 -pthread -I. bench/queue_bench.cpp -o queue_bench
+//     ./queue_bench [items per producer, default 1000000] [capacity, default 1024]
+//
+// Each consumer checks that the items of every producer reach it in the
+// order they were pushed, and the run checks that every item came out
+// exactly once, so a broken sequence number or a torn cell fails it.
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <pthread.h>
+#include <time.h>
+#include <stdint.h>
+#include "latency.hpp"
+#include "memory.hpp"
+#include "mpmc_queue.hpp"
+#include "spsc_ring.hpp"
+#include "queue.hpp"
+
+namespace {
+    const int max_threads = 4;
+    const int producer_shift = 40;
+    const size_t batch = 32;
+
+    struct item {
+        uint64_t value;
+        uint64_t stamp;
+    };
+
+    double seconds() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+    }
+
+    // Bounded like the lock-free queues, so producers cannot run ahead.
+    class locked_queue {
+    public:
+        explicit locked_queue( size_t capacity ): _capacity(capacity) { pthread_mutex_init(&_lock, NULL); }
+        ~locked_queue() { pthread_mutex_destroy(&_lock); }
+
+        void push( const item& value ) {
+            ft::spin_backoff backoff;
+            for (;;) {
+                pthread_mutex_lock(&_lock);
+                bool room = _queue.size() < _capacity;
+                if (room)
+                    _queue.push(value);
+                pthread_mutex_unlock(&_lock);
+                if (room)
+                    return;
+                backoff.pause();
+            }
+        }
+
+        void pop( item& out ) {
+            ft::spin_backoff backoff;
+            for (;;) {
+                pthread_mutex_lock(&_lock);
+                bool found = !_queue.empty();
+                if (found) {
+                    out = _queue.front();
+                    _queue.pop();
+                }
+                pthread_mutex_unlock(&_lock);
+                if (found)
+                    return;
+                backoff.pause();
+            }
+        }
+
+    private:
+        pthread_mutex_t _lock;
+        size_t _capacity;
+        ft::queue<item> _queue;
+    };
+
+    struct shared {
+        pthread_barrier_t start;
+        ft::latency_histogram latency;
+        int producers;
+        uint64_t per_producer;
+        bool batched;
+    };
+
+    template< class Queue >
+    struct worker {
+        Queue* queue;
+        shared* run;
+        int id;
+        uint64_t count;
+        uint64_t sum;
+        bool in_order;
+        double began;
+        double finished;
+    };
+
+    template< class Queue >
+    void push_items( worker<Queue>& w ) {
+        for (uint64_t seq = 0; seq < w.run->per_producer; ++seq) {
+            item it = { uint64_t(w.id) << producer_shift | seq, ft::latency_clock::now() };
+            w.queue->push(it);
+        }
+    }
+
+    template< class Queue >
+    void pop_items( worker<Queue>& w ) {
+        uint64_t next[max_threads] = { 0 };
+        for (uint64_t i = 0; i < w.run->per_producer; ++i) {
+            item it;
+            w.queue->pop(it);
+            w.run->latency.record(ft::latency_clock::now() - it.stamp);
+            uint64_t producer = it.value >> producer_shift;
+            uint64_t seq = it.value & ((uint64_t(1) << producer_shift) - 1);
+            if (producer >= uint64_t(w.run->producers) || seq < next[producer])
+                w.in_order = false;
+            else
+                next[producer] = seq + 1;
+            ++w.count;
+            w.sum += it.value;
+        }
+    }
+
+    // push_n and pop_n move up to a batch at a time and publish the index
+    // once per batch.
+    void push_items( worker<ft::spsc_ring<item> >& w ) {
+        if (!w.run->batched)
+            return push_items<ft::spsc_ring<item> >(w);
+        item items[batch];
+        for (uint64_t seq = 0; seq < w.run->per_producer; ) {
+            size_t n = 0;
+            for (; n < batch && seq + n < w.run->per_producer; ++n) {
+                item it = { seq + n, ft::latency_clock::now() };
+                items[n] = it;
+            }
+            ft::spin_backoff backoff;
+            for (size_t done = 0; done < n; ) {
+                size_t pushed = w.queue->push_n(items + done, n - done);
+                if (pushed == 0)
+                    backoff.pause();
+                done += pushed;
+            }
+            seq += n;
+        }
+    }
+
+    void pop_items( worker<ft::spsc_ring<item> >& w ) {
+        if (!w.run->batched)
+            return pop_items<ft::spsc_ring<item> >(w);
+        item items[batch];
+        ft::spin_backoff backoff;
+        while (w.count < w.run->per_producer) {
+            size_t n = w.queue->pop_n(items, batch);
+            if (n == 0) {
+                backoff.pause();
+                continue;
+            }
+            uint64_t now = ft::latency_clock::now();
+            for (size_t i = 0; i < n; ++i) {
+                w.run->latency.record(now - items[i].stamp);
+                if (items[i].value != w.count)
+                    w.in_order = false;
+                ++w.count;
+                w.sum += items[i].value;
+            }
+        }
+    }
+
+    template< class Queue >
+    void* produce( void* arg ) {
+        worker<Queue>& w = *static_cast<worker<Queue>*>(arg);
+        pthread_barrier_wait(&w.run->start);
+        w.began = seconds();
+        push_items(w);
+        w.finished = seconds();
+        return NULL;
+    }
+
+    template< class Queue >
+    void* consume( void* arg ) {
+        worker<Queue>& w = *static_cast<worker<Queue>*>(arg);
+        pthread_barrier_wait(&w.run->start);
+        w.began = seconds();
+        pop_items(w);
+        w.finished = seconds();
+        return NULL;
+    }
+
+    // Runs threads producers against as many consumers, each consumer
+    // taking per_producer items, and prints one line. The rate runs from
+    // the first thread starting to the last one finishing, as the threads
+    // time themselves: the main thread may not run until they are done.
+    template< class Queue >
+    void measure( const char* name, int threads, uint64_t per_producer, size_t capacity, bool batched = false ) {
+        Queue queue(capacity);
+        shared run;
+        pthread_barrier_init(&run.start, NULL, 2 * threads + 1);
+        run.producers = threads;
+        run.per_producer = per_producer;
+        run.batched = batched;
+        worker<Queue> producers[max_threads], consumers[max_threads];
+        pthread_t ids[2 * max_threads];
+        for (int t = 0; t < threads; ++t) {
+            worker<Queue> w = { &queue, &run, t, 0, 0, true, 0, 0 };
+            producers[t] = w;
+            consumers[t] = w;
+            pthread_create(&ids[2 * t], NULL, produce<Queue>, &producers[t]);
+            pthread_create(&ids[2 * t + 1], NULL, consume<Queue>, &consumers[t]);
+        }
+        pthread_barrier_wait(&run.start);
+        for (int t = 0; t < 2 * threads; ++t)
+            pthread_join(ids[t], NULL);
+        pthread_barrier_destroy(&run.start);
+        double began = producers[0].began, finished = 0;
+        for (int t = 0; t < threads; ++t) {
+            began = std::min(began, std::min(producers[t].began, consumers[t].began));
+            finished = std::max(finished, std::max(producers[t].finished, consumers[t].finished));
+        }
+        double elapsed = finished - began;
+
+        uint64_t count = 0, sum = 0, expected = 0;
+        bool in_order = true;
+        for (int t = 0; t < threads; ++t) {
+            count += consumers[t].count;
+            sum += consumers[t].sum;
+            in_order = in_order && consumers[t].in_order;
+            for (uint64_t seq = 0; seq < per_producer; ++seq)
+                expected += uint64_t(t) << producer_shift | seq;
+        }
+        if (count != threads * per_producer || sum != expected || !in_order) {
+            std::fprintf(stderr, "%s %d/%d: items lost, duplicated or out of order\n", name, threads, threads);
+            std::exit(1);
+        }
+        std::printf("%-14s %d/%-5d %14.2f %12llu %12llu %12llu\n", name, threads, threads, count / elapsed / 1e6,
+                    static_cast<unsigned long long>(run.latency.percentile(50)),
+                    static_cast<unsigned long long>(run.latency.percentile(99)),
+                    static_cast<unsigned long long>(run.latency.max()));
+    }
+}
+
+int main( int argc, char** argv ) {
+    uint64_t per_producer = argc > 1 ? std::strtoull(argv[1], NULL, 10) : 1000000;
+    size_t capacity = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 1024;
+    std::printf("%-14s %-7s %14s %12s %12s %12s   (latency in %s)\n", "queue", "P/C", "Mitems/s", "p50", "p99", "max",
+                ft::latency_clock::unit());
+    measure<ft::spsc_ring<item> >("spsc_ring", 1, per_producer, capacity);
+    measure<ft::spsc_ring<item> >("spsc_ring x32", 1, per_producer, capacity, true);
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        measure<ft::mpmc_queue<item> >("mpmc_queue", threads, per_producer, capacity);
+        measure<locked_queue>("mutex queue", threads, per_producer, capacity);
+    }
+    return 0;
+}
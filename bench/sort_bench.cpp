@@ -0,0 +1,138 @@
+// ft::sort and ft::stable_sort against std::sort and std::stable_sort on
+// random, sorted, reversed and few-unique inputs. Plain ints in a raw
+// array take the radix path; the same ints under std::greater and
+// std::string keys go through pattern-defeating quicksort and the merge
+// sort. Build and run from the repository root:
+//
+//     c++ -O2 -I. bench/sort_bench.cpp -o sort_bench
+//     ./sort_bench [elements, default 1000000] [runs, default 5]
+//
+// Times are the best of the runs, in milliseconds. Every result is
+// compared with the std one, so a wrong order fails the run.
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include <time.h>
+#include <stdint.h>
+#include "sort.hpp"
+
+namespace {
+    enum pattern { random_keys, sorted_keys, reversed_keys, few_unique_keys, pattern_count };
+
+    const char* const pattern_names[pattern_count] = { "random", "sorted", "reversed", "few unique" };
+
+    double seconds() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+    }
+
+    uint32_t next_random( uint32_t& state ) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    template<class T>
+    void order( std::vector<T>& keys, pattern p ) {
+        if (p == sorted_keys)
+            std::sort(keys.begin(), keys.end());
+        else if (p == reversed_keys)
+            std::sort(keys.begin(), keys.end(), std::greater<T>());
+    }
+
+    void make_ints( std::vector<int>& keys, size_t n, pattern p ) {
+        uint32_t state = 2463534242u;
+        keys.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            keys[i] = p == few_unique_keys ? static_cast<int>(next_random(state) % 16)
+                                           : static_cast<int>(next_random(state) >> 1) - (1 << 30);
+        order(keys, p);
+    }
+
+    void make_strings( std::vector<std::string>& keys, size_t n, pattern p ) {
+        uint32_t state = 88172645u;
+        keys.resize(n);
+        char buffer[32];
+        for (size_t i = 0; i < n; ++i) {
+            std::sprintf(buffer, "key-%010u", p == few_unique_keys ? next_random(state) % 16 : next_random(state));
+            keys[i] = buffer;
+        }
+        order(keys, p);
+    }
+
+    struct ft_sort {
+        template<class T, class Compare>
+        static void run( T* first, T* last, Compare comp ) { ft::sort(first, last, comp); }
+    };
+
+    struct std_sort {
+        template<class T, class Compare>
+        static void run( T* first, T* last, Compare comp ) { std::sort(first, last, comp); }
+    };
+
+    struct ft_stable_sort {
+        template<class T, class Compare>
+        static void run( T* first, T* last, Compare comp ) { ft::stable_sort(first, last, comp); }
+    };
+
+    struct std_stable_sort {
+        template<class T, class Compare>
+        static void run( T* first, T* last, Compare comp ) { std::stable_sort(first, last, comp); }
+    };
+
+    // Best time over runs, leaving the last sorted copy in out.
+    template<class Sorter, class T, class Compare>
+    double best_of( const std::vector<T>& keys, std::vector<T>& out, Compare comp, int runs ) {
+        double best = 0;
+        for (int r = 0; r < runs; ++r) {
+            out = keys;
+            double begin = seconds();
+            Sorter::run(&out[0], &out[0] + out.size(), comp);
+            double elapsed = seconds() - begin;
+            if (r == 0 || elapsed < best)
+                best = elapsed;
+        }
+        return best;
+    }
+
+    template<class FtSorter, class StdSorter, class T, class Compare>
+    void compare( const char* what, const char* input, const std::vector<T>& keys, Compare comp, int runs ) {
+        std::vector<T> ours, theirs;
+        double ft_time = best_of<FtSorter>(keys, ours, comp, runs);
+        double std_time = best_of<StdSorter>(keys, theirs, comp, runs);
+        if (ours != theirs) {
+            std::fprintf(stderr, "%s on %s keys: result differs from std\n", what, input);
+            std::exit(1);
+        }
+        std::printf("%-26s %-11s %10.2f %10.2f %8.2f\n", what, input, ft_time * 1e3, std_time * 1e3, std_time / ft_time);
+    }
+}
+
+int main( int argc, char** argv ) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (n == 0 || runs < 1) {
+        std::fprintf(stderr, "need at least one element and one run\n");
+        return 1;
+    }
+    std::printf("%-26s %-11s %10s %10s %8s\n", "sort", "input", "ft ms", "std ms", "speedup");
+    for (int p = 0; p < pattern_count; ++p) {
+        std::vector<int> ints;
+        std::vector<std::string> strings;
+        make_ints(ints, n, static_cast<pattern>(p));
+        make_strings(strings, n, static_cast<pattern>(p));
+        const char* input = pattern_names[p];
+        compare<ft_sort, std_sort>("sort int (radix)", input, ints, std::less<int>(), runs);
+        compare<ft_sort, std_sort>("sort int, greater", input, ints, std::greater<int>(), runs);
+        compare<ft_sort, std_sort>("sort string", input, strings, std::less<std::string>(), runs);
+        compare<ft_stable_sort, std_stable_sort>("stable_sort int (radix)", input, ints, std::less<int>(), runs);
+        compare<ft_stable_sort, std_stable_sort>("stable_sort int, greater", input, ints, std::greater<int>(), runs);
+        compare<ft_stable_sort, std_stable_sort>("stable_sort string", input, strings, std::less<std::string>(), runs);
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+// ft::vector growth, insert, erase and copy on the memcpy/memmove fast
+// paths against the element-by-element paths they replace. Each pair
+// stores the same bytes:
+//
+//     int            trivially copyable, every fast path
+//     boxed int      an int with a user-provided copy, so no fast path
+//     relocatable    owns a heap int, marked is_trivially_relocatable, so
+//                    growth and insert move it with memcpy
+//     owning         the same type without the mark
+//
+// Build and run from the repository root:
+//
+//     c++ -O2 -I. bench/vector_bench.cpp -o vector_bench
+//     ./vector_bench [elements, default 1000000] [runs, default 5]
+//
+// Times are the best of the runs, in milliseconds.
+#include <cstdio>
+#include <cstdlib>
+#include <time.h>
+#include "vector.hpp"
+
+namespace {
+    struct boxed_int {
+        int value;
+
+        boxed_int(): value(0) {}
+        explicit boxed_int( int v ): value(v) {}
+        boxed_int( const boxed_int& other ): value(other.value) {}
+        boxed_int& operator=( const boxed_int& other ) {
+            value = other.value;
+            return *this;
+        }
+        ~boxed_int() {}
+
+        int get() const { return value; }
+    };
+
+    template<bool Relocatable>
+    struct owning_int {
+        int* value;
+
+        owning_int(): value(new int(0)) {}
+        explicit owning_int( int v ): value(new int(v)) {}
+        owning_int( const owning_int& other ): value(new int(*other.value)) {}
+        owning_int& operator=( const owning_int& other ) {
+            *value = *other.value;
+            return *this;
+        }
+        ~owning_int() { delete value; }
+
+        int get() const { return *value; }
+    };
+
+    typedef owning_int<true> relocatable_int;
+    typedef owning_int<false> plain_owning_int;
+}
+
+namespace ft {
+    template<>
+    struct is_trivially_relocatable<relocatable_int> {
+        static const bool value = true;
+    };
+}
+
+namespace {
+    int get( int value ) { return value; }
+    template<class T>
+    int get( const T& value ) { return value.get(); }
+
+    double seconds() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+    }
+
+    // Keeps the results alive and checks them.
+    long checksum = 0;
+
+    template<class T>
+    void fill( ft::vector<T>& v, size_t n ) {
+        v.clear();
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            v.push_back(T(static_cast<int>(i)));
+    }
+
+    // push_back from empty, through every reallocation.
+    template<class T>
+    double growth( size_t n ) {
+        double begin = seconds();
+        ft::vector<T> v;
+        for (size_t i = 0; i < n; ++i)
+            v.push_back(T(static_cast<int>(i)));
+        double elapsed = seconds() - begin;
+        checksum += get(v[n / 2]);
+        return elapsed;
+    }
+
+    // Single inserts in the middle; each shifts half the elements.
+    template<class T>
+    double insert( size_t n ) {
+        ft::vector<T> v;
+        fill(v, n);
+        T value(7);
+        double begin = seconds();
+        for (int i = 0; i < 100; ++i)
+            v.insert(v.begin() + v.size() / 2, value);
+        double elapsed = seconds() - begin;
+        checksum += get(v[n / 2]);
+        return elapsed;
+    }
+
+    template<class T>
+    double erase( size_t n ) {
+        ft::vector<T> v;
+        fill(v, n);
+        double begin = seconds();
+        for (int i = 0; i < 100; ++i)
+            v.erase(v.begin() + v.size() / 2);
+        double elapsed = seconds() - begin;
+        checksum += get(v[v.size() / 2]);
+        return elapsed;
+    }
+
+    template<class T>
+    double copy( size_t n ) {
+        ft::vector<T> v;
+        fill(v, n);
+        double begin = seconds();
+        ft::vector<T> c(v);
+        double elapsed = seconds() - begin;
+        checksum += get(c[n / 2]);
+        return elapsed;
+    }
+
+    template<class T>
+    double best_of( double (*op)( size_t ), size_t n, int runs ) {
+        double best = 0;
+        for (int r = 0; r < runs; ++r) {
+            double t = op(n);
+            if (r == 0 || t < best)
+                best = t;
+        }
+        return best * 1e3;
+    }
+
+    void row( const char* name, double fast, double slow, double reloc, double owning ) {
+        std::printf("%-8s %10.2f %10.2f %8.2f %12.2f %10.2f %8.2f\n", name,
+                    fast, slow, slow / fast, reloc, owning, owning / reloc);
+    }
+}
+
+int main( int argc, char** argv ) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (n == 0 || runs < 1) {
+        std::fprintf(stderr, "need at least one element and one run\n");
+        return 1;
+    }
+    std::printf("%-8s %10s %10s %8s %12s %10s %8s   (ms)\n", "op", "int", "boxed int", "speedup",
+                "relocatable", "owning", "speedup");
+    row("growth", best_of<int>(growth<int>, n, runs), best_of<boxed_int>(growth<boxed_int>, n, runs),
+        best_of<relocatable_int>(growth<relocatable_int>, n, runs),
+        best_of<plain_owning_int>(growth<plain_owning_int>, n, runs));
+    row("insert", best_of<int>(insert<int>, n, runs), best_of<boxed_int>(insert<boxed_int>, n, runs),
+        best_of<relocatable_int>(insert<relocatable_int>, n, runs),
+        best_of<plain_owning_int>(insert<plain_owning_int>, n, runs));
+    row("erase", best_of<int>(erase<int>, n, runs), best_of<boxed_int>(erase<boxed_int>, n, runs),
+        best_of<relocatable_int>(erase<relocatable_int>, n, runs),
+        best_of<plain_owning_int>(erase<plain_owning_int>, n, runs));
+    row("copy", best_of<int>(copy<int>, n, runs), best_of<boxed_int>(copy<boxed_int>, n, runs),
+        best_of<relocatable_int>(copy<relocatable_int>, n, runs),
+        best_of<plain_owning_int>(copy<plain_owning_int>, n, runs));
+    std::printf("checksum %ld\n", checksum);
+    return 0;
+}
@@ -0,0 +1,274 @@
+#ifndef FT_CONTAINERS_CONCURRENT_STACK_HPP
+# define FT_CONTAINERS_CONCURRENT_STACK_HPP
+# include <memory>
+# include <cstddef>
+# include <stdexcept>
+# include <stdint.h>
+# include "type_traits.hpp"
+# include "memory.hpp"
+# include "concurrent_vector.hpp"
+
+namespace ft {
+    // Lock-free LIFO stack (Treiber) for any number of threads.
+    //
+    // Nodes come from a pool that only grows, an ft::concurrent_vector, and
+    // are named by their 32-bit index. The top of the stack is one 64-bit
+    // word holding that index and a tag bumped by every successful CAS, so a
+    // head that was popped and pushed back in between (ABA) no longer
+    // compares equal. Popped nodes go to a free list built the same way.
+    // Since node memory is never returned while the stack lives, reading the
+    // link of a node another thread just popped is harmless.
+    //
+    // When the CAS on the top fails, a thread tries the elimination array
+    // before backing off: a push parks its node in a random slot for a short
+    // while and a pop that finds it there takes it directly, so the pair
+    // completes without touching the top at all.
+    template< class T, class Alloc = std::allocator<T> >
+    class concurrent_stack {
+    public:
+        typedef T value_type;
+        typedef Alloc allocator_type;
+        typedef size_t size_type;
+
+        concurrent_stack(): _head(_pack(_nil, 0)), _free(_pack(_nil, 0)), _size(0) {
+            _reset_slots();
+        }
+        explicit concurrent_stack( const allocator_type& alloc ):
+            _nodes(node_allocator_type(alloc)), _head(_pack(_nil, 0)), _free(_pack(_nil, 0)), _size(0) {
+            _reset_slots();
+        }
+
+        ~concurrent_stack() {
+            for (uint32_t i = _index(_head); i != _nil; i = _nodes[i].next)
+                _nodes[i].value()->~T();
+        }
+
+        bool empty() const { return _index(__atomic_load_n(&_head, __ATOMIC_ACQUIRE)) == _nil; }
+
+        // Only a snapshot while other threads push or pop.
+        size_type size() const {
+            ptrdiff_t n = __atomic_load_n(&_size, __ATOMIC_RELAXED);
+            return n < 0 ? 0 : static_cast<size_type>(n);
+        }
+
+        // The top element, in place: only valid while no other thread pops.
+        T& top() { return *_nodes[_index(_head)].value(); }
+        const T& top() const { return *_nodes[_index(_head)].value(); }
+
+        void push( const T& value ) {
+            uint32_t n = _acquire_node();
+            try {
+                ::new (static_cast<void*>(_nodes[n].value())) T(value);
+            }
+            catch (...) {
+                _release_node(n);
+                throw;
+            }
+            _push_node(n);
+        }
+
+# if FT_CONTAINERS_CXX11
+        void push( T&& value ) {
+            emplace(std::move(value));
+        }
+
+        template< class... Args >
+        void emplace( Args&&... args ) {
+            uint32_t n = _acquire_node();
+            try {
+                ::new (static_cast<void*>(_nodes[n].value())) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                _release_node(n);
+                throw;
+            }
+            _push_node(n);
+        }
+# endif
+
+        // Moves the top element into out, or returns false if the stack was
+        // empty.
+        bool try_pop( T& out ) {
+            uint32_t n = _pop_node();
+            if (n == _nil)
+                return false;
+            T* value = _nodes[n].value();
+            out = FT_MOVE(*value);
+            value->~T();
+            _release_node(n);
+            return true;
+        }
+
+        // Drops the top element; false if there was none.
+        bool pop() {
+            uint32_t n = _pop_node();
+            if (n == _nil)
+                return false;
+            _nodes[n].value()->~T();
+            _release_node(n);
+            return true;
+        }
+
+    private:
+        struct _node {
+            char storage[sizeof(T)] __attribute__((aligned(__alignof__(T))));
+            uint32_t next;
+
+            T* value() { return reinterpret_cast<T*>(storage); }
+        };
+
+        struct _slot {
+            uint64_t offer;
+            char pad[cache_line_size - sizeof(uint64_t)];
+        };
+
+        typedef typename Alloc::template rebind<_node>::other node_allocator_type;
+
+        static const uint32_t _nil = 0xffffffffu;
+        static const size_t _elimination_slots = 8;
+        static const unsigned _elimination_spins = 128;
+        // Slot states; an offered node n is stored as n + _offered.
+        static const uint64_t _empty_slot = 0;
+        static const uint64_t _taken_slot = 1;
+        static const uint64_t _offered = 2;
+
+        concurrent_vector<_node, node_allocator_type> _nodes;
+        char _pad0[cache_line_size];
+        uint64_t _head;
+        char _pad1[cache_line_size - sizeof(uint64_t)];
+        uint64_t _free;
+        char _pad2[cache_line_size - sizeof(uint64_t)];
+        ptrdiff_t _size;
+        char _pad3[cache_line_size - sizeof(ptrdiff_t)];
+        _slot _slots[_elimination_slots];
+
+        concurrent_stack( const concurrent_stack& );
+        concurrent_stack& operator=( const concurrent_stack& );
+
+        static uint64_t _pack( uint32_t index, uint32_t tag ) { return static_cast<uint64_t>(tag) << 32 | index; }
+        static uint32_t _index( uint64_t word ) { return static_cast<uint32_t>(word); }
+        static uint32_t _tag( uint64_t word ) { return static_cast<uint32_t>(word >> 32); }
+
+        void _reset_slots() {
+            for (size_t i = 0; i < _elimination_slots; ++i)
+                _slots[i].offer = _empty_slot;
+        }
+
+        // One attempt to link node n on top of *top.
+        bool _try_push( uint64_t* top, uint32_t n ) {
+            uint64_t old = __atomic_load_n(top, __ATOMIC_RELAXED);
+            __atomic_store_n(&_nodes[n].next, _index(old), __ATOMIC_RELAXED);
+            return __atomic_compare_exchange_n(top, &old, _pack(n, _tag(old) + 1), false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+        }
+
+        // One attempt to unlink the node on top of *top. Returns _nil with
+        // contended set if another thread got in first.
+        uint32_t _try_pop( uint64_t* top, bool& contended ) {
+            uint64_t old = __atomic_load_n(top, __ATOMIC_ACQUIRE);
+            uint32_t n = _index(old);
+            if (n == _nil)
+                return _nil;
+            uint32_t next = __atomic_load_n(&_nodes[n].next, __ATOMIC_RELAXED);
+            if (__atomic_compare_exchange_n(top, &old, _pack(next, _tag(old) + 1), false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+                return n;
+            contended = true;
+            return _nil;
+        }
+
+        void _push_node( uint32_t n ) {
+            spin_backoff backoff;
+            for (;;) {
+                if (_try_push(&_head, n)) {
+                    __atomic_add_fetch(&_size, 1, __ATOMIC_RELAXED);
+                    return ;
+                }
+                if (_eliminate_push(n))
+                    return ;
+                backoff.pause();
+            }
+        }
+
+        uint32_t _pop_node() {
+            spin_backoff backoff;
+            for (;;) {
+                bool contended = false;
+                uint32_t n = _try_pop(&_head, contended);
+                if (n != _nil) {
+                    __atomic_sub_fetch(&_size, 1, __ATOMIC_RELAXED);
+                    return n;
+                }
+                if (!contended)
+                    return _nil;
+                n = _eliminate_pop();
+                if (n != _nil)
+                    return n;
+                backoff.pause();
+            }
+        }
+
+        // Parks node n in a slot for a few spins. True if a pop took it.
+        bool _eliminate_push( uint32_t n ) {
+            uint64_t* slot = &_slots[_slot_hint()].offer;
+            uint64_t offer = n + _offered;
+            uint64_t expected = _empty_slot;
+            if (!__atomic_compare_exchange_n(slot, &expected, offer, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+                return false;
+            for (unsigned i = 0; i < _elimination_spins && __atomic_load_n(slot, __ATOMIC_RELAXED) == offer; ++i)
+                cpu_relax();
+            expected = offer;
+            if (__atomic_compare_exchange_n(slot, &expected, _empty_slot, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                return false;
+            // Taken: only this thread may move the slot on from there.
+            __atomic_store_n(slot, _empty_slot, __ATOMIC_RELAXED);
+            return true;
+        }
+
+        uint32_t _eliminate_pop() {
+            uint64_t* slot = &_slots[_slot_hint()].offer;
+            uint64_t offer = __atomic_load_n(slot, __ATOMIC_RELAXED);
+            if (offer < _offered)
+                return _nil;
+            if (__atomic_compare_exchange_n(slot, &offer, _taken_slot, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                return static_cast<uint32_t>(offer - _offered);
+            return _nil;
+        }
+
+        // Per-thread xorshift, so threads spread over the slots without
+        // sharing any state.
+        static size_t _slot_hint() {
+            static __thread uint32_t state = 0;
+            if (state == 0)
+                state = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&state) >> 4) | 1;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state % _elimination_slots;
+        }
+
+        // A node from the free list, or a new one from the pool.
+        uint32_t _acquire_node() {
+            spin_backoff backoff;
+            for (;;) {
+                bool contended = false;
+                uint32_t n = _try_pop(&_free, contended);
+                if (n != _nil)
+                    return n;
+                if (!contended)
+                    break;
+                backoff.pause();
+            }
+            size_t index = _nodes.grow_by(1) - _nodes.begin();
+            if (index >= _nil)
+                throw std::length_error("concurrent_stack: too many nodes");
+            return static_cast<uint32_t>(index);
+        }
+
+        void _release_node( uint32_t n ) {
+            spin_backoff backoff;
+            while (!_try_push(&_free, n))
+                backoff.pause();
+        }
+    };
+}
+
+#endif//FT_CONTAINERS_CONCURRENT_STACK_HPP
@@ -0,0 +1,459 @@
+#ifndef FT_CONTAINERS_CONCURRENT_VECTOR_HPP
+# define FT_CONTAINERS_CONCURRENT_VECTOR_HPP
+# include <memory>
+# include <cstddef>
+# include <climits>
+# include <cstring>
+# include <stdexcept>
+# include <limits>
+# include <algorithm>
+# include <iterator>
+# include "algorithm.hpp"
+# include "iterator.hpp"
+# include "vector_iterator.hpp"
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+namespace ft {
+    template< class T, class Alloc >
+    class concurrent_vector;
+
+    // A position is an element index, so iterators survive growth and only
+    // need the vector to locate the segment holding it.
+    template<class T, class Alloc, class Ref, class Ptr>
+    class concurrent_vector_iterator {
+    public:
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef concurrent_vector<T, Alloc> container_type;
+
+        concurrent_vector_iterator(): _owner(NULL), _pos(0) {}
+        concurrent_vector_iterator(const container_type* owner, difference_type pos): _owner(owner), _pos(pos) {}
+        concurrent_vector_iterator(const concurrent_vector_iterator<T, Alloc, T&, T*> & other): _owner(other.owner()), _pos(other.pos()) {}
+
+        reference operator*() const { return const_cast<reference>((*_owner)[_pos]); }
+        pointer operator->() const { return &(operator*()); }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        concurrent_vector_iterator& operator++() { ++_pos; return *this; }
+        concurrent_vector_iterator operator++(int) { concurrent_vector_iterator tmp(*this); ++_pos; return tmp; }
+        concurrent_vector_iterator& operator--() { --_pos; return *this; }
+        concurrent_vector_iterator operator--(int) { concurrent_vector_iterator tmp(*this); --_pos; return tmp; }
+        concurrent_vector_iterator& operator+=(difference_type n) { _pos += n; return *this; }
+        concurrent_vector_iterator& operator-=(difference_type n) { _pos -= n; return *this; }
+        concurrent_vector_iterator operator+(difference_type n) const { return concurrent_vector_iterator(_owner, _pos + n); }
+        concurrent_vector_iterator operator-(difference_type n) const { return concurrent_vector_iterator(_owner, _pos - n); }
+        difference_type operator-(const concurrent_vector_iterator& other) const { return _pos - other._pos; }
+
+        bool operator==(const concurrent_vector_iterator& other) const { return _pos == other._pos; }
+        bool operator!=(const concurrent_vector_iterator& other) const { return _pos != other._pos; }
+        bool operator<(const concurrent_vector_iterator& other) const { return _pos < other._pos; }
+        bool operator<=(const concurrent_vector_iterator& other) const { return _pos <= other._pos; }
+        bool operator>(const concurrent_vector_iterator& other) const { return _pos > other._pos; }
+        bool operator>=(const concurrent_vector_iterator& other) const { return _pos >= other._pos; }
+
+        const container_type* owner() const { return _owner; }
+        difference_type pos() const { return _pos; }
+
+    private:
+        const container_type* _owner;
+        difference_type _pos;
+    };
+
+    template<class T, class Alloc, class Ref, class Ptr>
+    concurrent_vector_iterator<T, Alloc, Ref, Ptr> operator+(typename concurrent_vector_iterator<T, Alloc, Ref, Ptr>::difference_type n,
+                                                             const concurrent_vector_iterator<T, Alloc, Ref, Ptr>& it) {
+        return it + n;
+    }
+
+    // Append-only vector that many threads can grow at once. Elements live in
+    // segments of 16, 32, 64, ... slots that are allocated on demand and never
+    // moved, so references and iterators stay valid while the vector grows.
+    // push_back and grow_by claim their slots with a single fetch-add on the
+    // size; indexed reads are two loads and never wait.
+    //
+    // size() counts claimed slots, so an element may be read only once the
+    // push_back or grow_by that returned it has completed, or after some
+    // other synchronisation with the writer. clear(), shrink_to_fit(), swap
+    // and assignment must not run concurrently with anything else.
+    //
+    // If constructing an element, or allocating its segment, throws, the
+    // slot is already claimed and stays empty: size() still counts it, at()
+    // throws for it, and operator[] and iterators must not read it. Copies
+    // keep such slots empty at the same index.
+    template< class T, class Alloc = std::allocator<T> >
+    class concurrent_vector {
+    public:
+        typedef T value_type;
+        typedef Alloc allocator_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef typename allocator_type::reference reference;
+        typedef typename allocator_type::const_reference const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef concurrent_vector_iterator<T, Alloc, T&, T*> iterator;
+        typedef concurrent_vector_iterator<T, Alloc, const T&, const T*> const_iterator;
+        typedef reverse_vector_iterator<iterator> reverse_iterator;
+        typedef reverse_vector_iterator<const_iterator> const_reverse_iterator;
+
+        concurrent_vector(): _size(0), _allocator(allocator_type()) {
+            _reset_segments();
+        }
+        explicit concurrent_vector( const allocator_type& alloc ): _size(0), _allocator(alloc) {
+            _reset_segments();
+        }
+
+        explicit concurrent_vector( size_type count,
+                                   const T& value = T(),
+                                   const allocator_type& alloc = allocator_type() ): _size(0), _allocator(alloc) {
+            _reset_segments();
+            _guard(count, value);
+        }
+
+        template< class InputIt >
+        concurrent_vector( InputIt first, InputIt last, const Alloc& alloc = Alloc(), typename enable_if<!is_integral<InputIt>::value, bool >::type = true ):
+            _size(0), _allocator(alloc) {
+            _reset_segments();
+            try {
+                for ( ; first != last ; ++first)
+                    push_back(*first);
+            }
+            catch (...) {
+                _release();
+                throw;
+            }
+        }
+
+        concurrent_vector( const concurrent_vector& other ): _size(0), _allocator(other._allocator) {
+            _reset_segments();
+            try {
+                _append(other);
+            }
+            catch (...) {
+                _release();
+                throw;
+            }
+        }
+
+        ~concurrent_vector() {
+            _release();
+        }
+
+        concurrent_vector& operator=( const concurrent_vector& other ) {
+            if (this != &other) {
+                clear();
+                _append(other);
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return _allocator; }
+
+        reference operator[]( size_type pos ) { return _slot(pos); }
+        const_reference operator[]( size_type pos ) const { return _slot(pos); }
+
+        reference at( size_type pos ) {
+            _check(pos);
+            return _slot(pos);
+        }
+        const_reference at( size_type pos ) const {
+            _check(pos);
+            return _slot(pos);
+        }
+
+        reference front() { return _slot(0); }
+        const_reference front() const { return _slot(0); }
+        reference back() { return _slot(size() - 1); }
+        const_reference back() const { return _slot(size() - 1); }
+
+        // end() is taken at the time of the call; elements appended later
+        // are not part of the range.
+        iterator begin() { return iterator(this, 0); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        iterator end() { return iterator(this, size()); }
+        const_iterator end() const { return const_iterator(this, size()); }
+        reverse_iterator rbegin() { return reverse_iterator(end() - 1); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end() - 1); }
+        reverse_iterator rend() { return reverse_iterator(begin() - 1); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin() - 1); }
+
+        bool empty() const { return size() == 0; }
+        size_type size() const { return __atomic_load_n(&_size, __ATOMIC_ACQUIRE); }
+        size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(value_type); }
+
+        // Slots available without allocating another segment.
+        size_type capacity() const {
+            size_type k = 0;
+            while (k < _segment_count && __atomic_load_n(&_segments[k], __ATOMIC_ACQUIRE) != NULL)
+                ++k;
+            return _segment_base(k);
+        }
+
+        memory_footprint memory_usage() const {
+            memory_footprint usage;
+            size_type slots = 0;
+            for (size_type k = 0; k < _segment_count; ++k)
+                if (__atomic_load_n(&_segments[k], __ATOMIC_ACQUIRE) != NULL)
+                    slots += _segment_size(k);
+            size_type n = size();
+            usage.payload = n * sizeof(T);
+            usage.node_overhead = slots;
+            usage.unused_capacity = (slots - n) * sizeof(T);
+            return usage;
+        }
+
+        // Allocates the segments for the first new_cap elements up front.
+        void reserve( size_type new_cap ) {
+            if (new_cap > max_size())
+                throw std::length_error("concurrent_vector::reserve");
+            if (new_cap == 0)
+                return ;
+            for (size_type k = 0, last = _segment_of(new_cap - 1); k <= last; ++k)
+                _segment(k);
+        }
+
+        // Frees the segments past the one holding the last element.
+        void shrink_to_fit() {
+            size_type keep = _size == 0 ? 0 : _segment_of(_size - 1) + 1;
+            for (size_type k = keep; k < _segment_count; ++k)
+                if (_segments[k] != NULL) {
+                    _allocator.deallocate(_segments[k], _segment_alloc_size(k));
+                    _segments[k] = NULL;
+                }
+        }
+
+        // Destroys the elements but keeps the segments for reuse.
+        void clear() {
+            _destroy_all();
+            _size = 0;
+        }
+
+        iterator push_back( const T& value ) {
+            size_type index = _claim(1);
+            T* p = &_prepare(index);
+            _allocator.construct(p, value);
+            _mark(index);
+            return iterator(this, index);
+        }
+
+# if FT_CONTAINERS_CXX11
+        iterator push_back( T&& value ) {
+            return emplace_back(std::move(value));
+        }
+
+        template< class... Args >
+        iterator emplace_back( Args&&... args ) {
+            size_type index = _claim(1);
+            T* p = &_prepare(index);
+            _allocator.construct(p, std::forward<Args>(args)...);
+            _mark(index);
+            return iterator(this, index);
+        }
+# endif
+
+        // Appends count copies of value as one contiguous run of indices and
+        // returns an iterator to the first of them.
+        iterator grow_by( size_type count, const T& value = T() ) {
+            size_type index = _claim(count);
+            _fill(index, count, value);
+            return iterator(this, index);
+        }
+
+        template< class ForwardIt >
+        typename enable_if<!is_integral<ForwardIt>::value, iterator >::type grow_by( ForwardIt first, ForwardIt last ) {
+            size_type count = std::distance(first, last);
+            size_type index = _claim(count);
+            for (size_type i = index ; first != last ; ++first, ++i) {
+                _allocator.construct(&_prepare(i), *first);
+                _mark(i);
+            }
+            return iterator(this, index);
+        }
+
+        // Grows the vector to at least count elements, appending copies of
+        // value if it is shorter, and returns an iterator to element count - 1
+        // or to begin() for count == 0.
+        iterator grow_to_at_least( size_type count, const T& value = T() ) {
+            size_type current = size();
+            while (current < count) {
+                if (__atomic_compare_exchange_n(&_size, &current, count, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                    _fill(current, count - current, value);
+                    break;
+                }
+            }
+            return iterator(this, count == 0 ? 0 : count - 1);
+        }
+
+        void swap( concurrent_vector& other ) {
+            for (size_type k = 0; k < _segment_count; ++k)
+                std::swap(_segments[k], other._segments[k]);
+            std::swap(_size, other._size);
+            std::swap(_allocator, other._allocator);
+        }
+
+    private:
+        static const size_type _base_log = 4;
+        static const size_type _base = size_type(1) << _base_log;
+        static const size_type _segment_count = sizeof(size_type) * CHAR_BIT - _base_log;
+
+        T* _segments[_segment_count];
+        size_type _size;
+        allocator_type _allocator;
+
+        // Segment k holds indices [_base * (2^k - 1), _base * (2^(k+1) - 1)),
+        // followed by one byte per slot that is set once its element is
+        // constructed.
+        static size_type _segment_of( size_type index ) {
+            return sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl(static_cast<unsigned long>(index + _base)) - _base_log;
+        }
+        static size_type _segment_base( size_type k ) { return (_base << k) - _base; }
+        static size_type _segment_size( size_type k ) { return _base << k; }
+        static size_type _segment_alloc_size( size_type k ) {
+            return _segment_size(k) + (_segment_size(k) + sizeof(T) - 1) / sizeof(T);
+        }
+        static unsigned char* _flags( T* seg, size_type k ) {
+            return reinterpret_cast<unsigned char*>(seg + _segment_size(k));
+        }
+
+        T& _slot( size_type index ) const {
+            size_type k = _segment_of(index);
+            return __atomic_load_n(&_segments[k], __ATOMIC_ACQUIRE)[index - _segment_base(k)];
+        }
+
+        // Returns segment k, allocating it if no other thread has yet. A
+        // thread that loses the race frees its copy and uses the winner's.
+        T* _segment( size_type k ) {
+            T* seg = __atomic_load_n(&_segments[k], __ATOMIC_ACQUIRE);
+            if (seg != NULL)
+                return seg;
+            T* fresh = _allocator.allocate(_segment_alloc_size(k));
+            std::memset(_flags(fresh, k), 0, _segment_size(k));
+            if (__atomic_compare_exchange_n(&_segments[k], &seg, fresh, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+                return fresh;
+            _allocator.deallocate(fresh, _segment_alloc_size(k));
+            return seg;
+        }
+
+        // Whether slot index holds an element, i.e. its segment exists and
+        // its constructor has returned.
+        bool _live( size_type index ) const {
+            size_type k = _segment_of(index);
+            T* seg = __atomic_load_n(&_segments[k], __ATOMIC_ACQUIRE);
+            return seg != NULL && __atomic_load_n(&_flags(seg, k)[index - _segment_base(k)], __ATOMIC_ACQUIRE);
+        }
+
+        void _mark( size_type index ) {
+            size_type k = _segment_of(index);
+            __atomic_store_n(&_flags(_segments[k], k)[index - _segment_base(k)], 1, __ATOMIC_RELEASE);
+        }
+
+        void _check( size_type pos ) const {
+            if (pos >= size())
+                throw std::out_of_range("Index out of range");
+            if (!_live(pos))
+                throw std::out_of_range("concurrent_vector: slot holds no element");
+        }
+
+        T& _prepare( size_type index ) {
+            size_type k = _segment_of(index);
+            return _segment(k)[index - _segment_base(k)];
+        }
+
+        size_type _claim( size_type count ) {
+            if (count > max_size() - size())
+                throw std::length_error("concurrent_vector: too many elements");
+            return __atomic_fetch_add(&_size, count, __ATOMIC_ACQ_REL);
+        }
+
+        void _fill( size_type index, size_type count, const T& value ) {
+            for (size_type i = index ; i < index + count ; ++i) {
+                _allocator.construct(&_prepare(i), value);
+                _mark(i);
+            }
+        }
+
+        // Copies other slot by slot, leaving its empty slots empty here too.
+        void _append( const concurrent_vector& other ) {
+            size_type count = other.size();
+            size_type index = _claim(count);
+            for (size_type i = 0; i < count; ++i)
+                if (other._live(i)) {
+                    _allocator.construct(&_prepare(index + i), other._slot(i));
+                    _mark(index + i);
+                }
+        }
+
+        // Destroys every element and marks its slot empty.
+        void _destroy_all() {
+            for (size_type i = 0; i < _size; ++i)
+                if (_live(i)) {
+                    size_type k = _segment_of(i);
+                    _allocator.destroy(_segments[k] + (i - _segment_base(k)));
+                    _flags(_segments[k], k)[i - _segment_base(k)] = 0;
+                }
+        }
+
+        void _guard( size_type count, const T& value ) {
+            try {
+                grow_by(count, value);
+            }
+            catch (...) {
+                _release();
+                throw;
+            }
+        }
+
+        void _reset_segments() {
+            for (size_type k = 0; k < _segment_count; ++k)
+                _segments[k] = NULL;
+        }
+
+        void _release() {
+            _destroy_all();
+            _size = 0;
+            for (size_type k = 0; k < _segment_count; ++k)
+                if (_segments[k] != NULL) {
+                    _allocator.deallocate(_segments[k], _segment_alloc_size(k));
+                    _segments[k] = NULL;
+                }
+        }
+    };
+
+    template< class T, class Alloc >
+    bool operator==( const ft::concurrent_vector<T,Alloc>& lhs,
+                    const ft::concurrent_vector<T,Alloc>& rhs ) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template< class T, class Alloc >
+    bool operator!=( const ft::concurrent_vector<T,Alloc>& lhs,
+                    const ft::concurrent_vector<T,Alloc>& rhs ) { return !(lhs == rhs); }
+
+    template< class T, class Alloc >
+    bool operator<( const ft::concurrent_vector<T,Alloc>& lhs,
+                   const ft::concurrent_vector<T,Alloc>& rhs ) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template< class T, class Alloc >
+    bool operator>( const ft::concurrent_vector<T,Alloc>& lhs,
+                   const ft::concurrent_vector<T,Alloc>& rhs ) { return rhs < lhs; }
+
+    template< class T, class Alloc >
+    bool operator<=( const ft::concurrent_vector<T,Alloc>& lhs,
+                    const ft::concurrent_vector<T,Alloc>& rhs ) { return !(rhs < lhs); }
+
+    template< class T, class Alloc >
+    bool operator>=( const ft::concurrent_vector<T,Alloc>& lhs,
+                    const ft::concurrent_vector<T,Alloc>& rhs ) { return !(lhs < rhs); }
+
+    template< class T, class Alloc >
+    void swap( ft::concurrent_vector<T,Alloc>& lhs,
+              ft::concurrent_vector<T,Alloc>& rhs ) { lhs.swap(rhs); }
+}
+
+#endif//FT_CONTAINERS_CONCURRENT_VECTOR_HPP
@@ -0,0 +1,437 @@
+#ifndef FT_CONTAINERS_DEQUE_HPP
+# define FT_CONTAINERS_DEQUE_HPP
+# include <memory>
+# include <cstddef>
+# include <stdexcept>
+# include <limits>
+# include <algorithm>
+# include "algorithm.hpp"
+# include "iterator.hpp"
+# include "vector_iterator.hpp"
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+namespace ft {
+    // Elements per block: roughly one page, but never fewer than 16 slots.
+    template<class T>
+    struct deque_block_size {
+        static const size_t value = sizeof(T) <= 256 ? 4096 / sizeof(T) : 16;
+    };
+
+    // A position is a global slot index into the block map, so iterators stay
+    // trivially comparable and only need the map to locate their block.
+    template<class T, class Ref, class Ptr>
+    class deque_iterator {
+    public:
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T** map_pointer;
+
+        deque_iterator(): _map(NULL), _pos(0) {}
+        deque_iterator(map_pointer map, difference_type pos): _map(map), _pos(pos) {}
+        deque_iterator(const deque_iterator<T, T&, T*> & other): _map(other.map()), _pos(other.pos()) {}
+
+        deque_iterator& operator=(const deque_iterator& other) {
+            if (this != &other) {
+                _map = other._map;
+                _pos = other._pos;
+            }
+            return *this;
+        }
+
+        reference operator*() const { return _map[_pos / _block][_pos % _block]; }
+        pointer operator->() const { return &(operator*()); }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        deque_iterator& operator++() { ++_pos; return *this; }
+        deque_iterator operator++(int) { deque_iterator tmp(*this); ++_pos; return tmp; }
+        deque_iterator& operator--() { --_pos; return *this; }
+        deque_iterator operator--(int) { deque_iterator tmp(*this); --_pos; return tmp; }
+        deque_iterator& operator+=(difference_type n) { _pos += n; return *this; }
+        deque_iterator& operator-=(difference_type n) { _pos -= n; return *this; }
+        deque_iterator operator+(difference_type n) const { return deque_iterator(_map, _pos + n); }
+        deque_iterator operator-(difference_type n) const { return deque_iterator(_map, _pos - n); }
+        difference_type operator-(const deque_iterator& other) const { return _pos - other._pos; }
+
+        bool operator==(const deque_iterator& other) const { return _pos == other._pos; }
+        bool operator!=(const deque_iterator& other) const { return _pos != other._pos; }
+        bool operator<(const deque_iterator& other) const { return _pos < other._pos; }
+        bool operator<=(const deque_iterator& other) const { return _pos <= other._pos; }
+        bool operator>(const deque_iterator& other) const { return _pos > other._pos; }
+        bool operator>=(const deque_iterator& other) const { return _pos >= other._pos; }
+
+        map_pointer map() const { return _map; }
+        difference_type pos() const { return _pos; }
+
+    private:
+        static const difference_type _block = deque_block_size<T>::value;
+        map_pointer _map;
+        difference_type _pos;
+    };
+
+    template<class T, class Ref, class Ptr>
+    deque_iterator<T, Ref, Ptr> operator+(typename deque_iterator<T, Ref, Ptr>::difference_type n,
+                                          const deque_iterator<T, Ref, Ptr>& it) {
+        return it + n;
+    }
+
+    template< class T, class Alloc = std::allocator<T> >
+    class deque {
+    public:
+        typedef T value_type;
+        typedef Alloc allocator_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef typename allocator_type::reference reference;
+        typedef typename allocator_type::const_reference const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef deque_iterator<T, T&, T*> iterator;
+        typedef deque_iterator<T, const T&, const T*> const_iterator;
+        typedef reverse_vector_iterator<iterator> reverse_iterator;
+        typedef reverse_vector_iterator<const_iterator> const_reverse_iterator;
+
+        deque(): _map(NULL), _map_size(0), _start(0), _size(0), _allocator(allocator_type()) {}
+        explicit deque( const allocator_type& alloc ): _map(NULL), _map_size(0), _start(0), _size(0), _allocator(alloc) {}
+
+        explicit deque( size_type count,
+                       const T& value = T(),
+                       const allocator_type& alloc = allocator_type() ): _map(NULL), _map_size(0), _start(0), _size(0), _allocator(alloc) {
+            _fill_back(count, value);
+        }
+
+        template< class InputIt >
+        deque( InputIt first, InputIt last, const Alloc& alloc = Alloc(), typename enable_if<!is_integral<InputIt>::value, bool >::type = true ):
+            _map(NULL), _map_size(0), _start(0), _size(0), _allocator(alloc) {
+            _append(first, last);
+        }
+
+        deque( const deque& other ): _map(NULL), _map_size(0), _start(0), _size(0), _allocator(other._allocator) {
+            _append(other.begin(), other.end());
+        }
+
+        ~deque() {
+            clear();
+            _release_map();
+        }
+
+        deque& operator=( const deque& other ) {
+            if (this != &other) {
+                clear();
+                _append(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        void assign( size_type count, const T& value ) {
+            clear();
+            _fill_back(count, value);
+        }
+
+        template< class InputIt >
+        typename enable_if<!is_integral<InputIt>::value, void >::type assign( InputIt first, InputIt last ) {
+            clear();
+            _append(first, last);
+        }
+
+        allocator_type get_allocator() const { return _allocator; }
+
+        reference operator[]( size_type pos ) { return _slot(_start + pos); }
+        const_reference operator[]( size_type pos ) const { return _slot(_start + pos); }
+
+        reference at( size_type pos ) {
+            if (pos >= _size)
+                throw std::out_of_range("Index out of range");
+            return _slot(_start + pos);
+        }
+        const_reference at( size_type pos ) const {
+            if (pos >= _size)
+                throw std::out_of_range("Index out of range");
+            return _slot(_start + pos);
+        }
+
+        reference front() { return _slot(_start); }
+        const_reference front() const { return _slot(_start); }
+        reference back() { return _slot(_start + _size - 1); }
+        const_reference back() const { return _slot(_start + _size - 1); }
+
+        iterator begin() { return iterator(_map, _start); }
+        const_iterator begin() const { return const_iterator(_map, _start); }
+        iterator end() { return iterator(_map, _start + _size); }
+        const_iterator end() const { return const_iterator(_map, _start + _size); }
+        reverse_iterator rbegin() { return reverse_iterator(end() - 1); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end() - 1); }
+        reverse_iterator rend() { return reverse_iterator(begin() - 1); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin() - 1); }
+
+        bool empty() const { return _size == 0; }
+        size_type size() const { return _size; }
+        size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(value_type); }
+
+        // The block map is the per-node overhead; free slots in allocated
+        // blocks, spare blocks included, are unused capacity.
+        memory_footprint memory_usage() const {
+            memory_footprint usage;
+            size_type blocks = 0;
+            for (size_type i = 0; i < _map_size; ++i)
+                if (_map[i] != NULL)
+                    ++blocks;
+            usage.payload = _size * sizeof(T);
+            usage.node_overhead = _map_size * sizeof(T*);
+            usage.unused_capacity = (blocks * _block - _size) * sizeof(T);
+            return usage;
+        }
+
+        void clear() {
+            while (_size != 0)
+                pop_back();
+        }
+
+        void push_back( const T& value ) {
+            size_type slot = _start + _size;
+            if (slot == _map_size * _block) {
+                _recenter_map();
+                slot = _start + _size;
+            }
+            T* block = _acquire_block(slot / _block);
+            _allocator.construct(block + slot % _block, value);
+            ++_size;
+        }
+
+        void push_front( const T& value ) {
+            if (_map == NULL || _start == 0)
+                _recenter_map();
+            size_type slot = _start - 1;
+            T* block = _acquire_block(slot / _block);
+            _allocator.construct(block + slot % _block, value);
+            _start = slot;
+            ++_size;
+        }
+
+        void pop_back() {
+            size_type slot = _start + _size - 1;
+            _allocator.destroy(&_slot(slot));
+            --_size;
+            if (_size == 0)
+                _rewind(slot);
+            else if (slot % _block == 0)
+                _release_block(slot / _block);
+        }
+
+        void pop_front() {
+            size_type slot = _start;
+            _allocator.destroy(&_slot(slot));
+            --_size;
+            if (_size == 0)
+                _rewind(slot);
+            else {
+                ++_start;
+                if (_start % _block == 0)
+                    _release_block(slot / _block);
+            }
+        }
+
+        void resize( size_type count, T value = T() ) {
+            while (_size > count)
+                pop_back();
+            if (count > _size)
+                _fill_back(count - _size, value);
+        }
+
+        iterator insert( const_iterator pos, const T& value ) {
+            return insert(pos, 1, value);
+        }
+
+        iterator insert( const_iterator pos, size_type count, const T& value ) {
+            size_type index = pos - begin();
+            size_type old_size = _size;
+            if (index < _size / 2) {
+                _fill_front(count, value);
+                std::rotate(begin(), begin() + count, begin() + count + index);
+            }
+            else {
+                _fill_back(count, value);
+                std::rotate(begin() + index, begin() + old_size, end());
+            }
+            return begin() + index;
+        }
+
+        template< class InputIt >
+        typename enable_if<!is_integral<InputIt>::value, iterator >::type insert( const_iterator pos, InputIt first, InputIt last ) {
+            size_type index = pos - begin();
+            size_type old_size = _size;
+            _append(first, last);
+            std::rotate(begin() + index, begin() + old_size, end());
+            return begin() + index;
+        }
+
+        iterator erase( const_iterator pos ) {
+            return erase(pos, pos + 1);
+        }
+
+        // Shifts whichever side of the gap is shorter, then pops the vacated
+        // slots off that end.
+        iterator erase( const_iterator first, const_iterator last ) {
+            difference_type index = first - begin();
+            difference_type count = last - first;
+            if (count <= 0)
+                return begin() + index;
+            iterator f = begin() + index;
+            if (static_cast<size_type>(index) < (_size - count) / 2) {
+                std::copy_backward(begin(), f, f + count);
+                for ( ; count != 0 ; --count)
+                    pop_front();
+            }
+            else {
+                std::copy(f + count, end(), f);
+                for ( ; count != 0 ; --count)
+                    pop_back();
+            }
+            return begin() + index;
+        }
+
+        void swap( deque& other ) {
+            std::swap(_map, other._map);
+            std::swap(_map_size, other._map_size);
+            std::swap(_start, other._start);
+            std::swap(_size, other._size);
+            std::swap(_allocator, other._allocator);
+            std::swap(_map_allocator, other._map_allocator);
+        }
+
+    private:
+        typedef typename Alloc::template rebind<T*>::other map_allocator_type;
+        static const size_type _block = deque_block_size<T>::value;
+
+        T** _map;
+        size_type _map_size;
+        size_type _start;
+        size_type _size;
+        allocator_type _allocator;
+        map_allocator_type _map_allocator;
+
+        T& _slot(size_type slot) const { return _map[slot / _block][slot % _block]; }
+
+        T* _acquire_block(size_type b) {
+            if (_map[b] == NULL)
+                _map[b] = _allocator.allocate(_block);
+            return _map[b];
+        }
+
+        void _release_block(size_type b) {
+            _allocator.deallocate(_map[b], _block);
+            _map[b] = NULL;
+        }
+
+        // The last element left the deque: keep its block as a spare and
+        // restart from its middle so either end can grow without a new block.
+        void _rewind(size_type slot) {
+            _start = slot - slot % _block + _block / 2;
+        }
+
+        size_type _used_blocks() const {
+            if (_map == NULL)
+                return 0;
+            if (_size == 0)
+                return _map[_start / _block] ? 1 : 0;
+            return (_start + _size - 1) / _block - _start / _block + 1;
+        }
+
+        // Moves the used block pointers to the middle of the map, growing it
+        // when more than half is in use. Elements themselves never move.
+        void _recenter_map() {
+            size_type used = _used_blocks();
+            size_type first = _map ? _start / _block : 0;
+            size_type new_size = _map_size;
+            if (used * 2 + 2 > _map_size)
+                new_size = std::max<size_type>(used * 2 + 2, 8);
+            size_type new_first = (new_size - used) / 2;
+            if (new_size != _map_size) {
+                T** new_map = _map_allocator.allocate(new_size);
+                std::fill(new_map, new_map + new_size, static_cast<T*>(NULL));
+                if (used != 0)
+                    std::copy(_map + first, _map + first + used, new_map + new_first);
+                if (_map != NULL)
+                    _map_allocator.deallocate(_map, _map_size);
+                _map = new_map;
+                _map_size = new_size;
+            }
+            else if (new_first < first) {
+                std::copy(_map + first, _map + first + used, _map + new_first);
+                std::fill(_map + std::max(first, new_first + used), _map + first + used, static_cast<T*>(NULL));
+            }
+            else if (new_first > first) {
+                std::copy_backward(_map + first, _map + first + used, _map + new_first + used);
+                std::fill(_map + first, _map + std::min(new_first, first + used), static_cast<T*>(NULL));
+            }
+            if (used == 0)
+                _start = new_first * _block + _block / 2;
+            else
+                _start = new_first * _block + _start % _block;
+        }
+
+        void _release_map() {
+            if (_map == NULL)
+                return ;
+            for (size_type i = 0; i < _map_size; ++i)
+                if (_map[i] != NULL)
+                    _allocator.deallocate(_map[i], _block);
+            _map_allocator.deallocate(_map, _map_size);
+            _map = NULL;
+            _map_size = 0;
+        }
+
+        void _fill_back(size_type count, const T& value) {
+            for ( ; count != 0 ; --count)
+                push_back(value);
+        }
+
+        void _fill_front(size_type count, const T& value) {
+            for ( ; count != 0 ; --count)
+                push_front(value);
+        }
+
+        template<class InputIt>
+        void _append(InputIt first, InputIt last) {
+            for ( ; first != last ; ++first)
+                push_back(*first);
+        }
+    };
+
+    template< class T, class Alloc >
+    bool operator==( const ft::deque<T,Alloc>& lhs,
+                    const ft::deque<T,Alloc>& rhs ) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template< class T, class Alloc >
+    bool operator!=( const ft::deque<T,Alloc>& lhs,
+                    const ft::deque<T,Alloc>& rhs ) { return !(lhs == rhs); }
+
+    template< class T, class Alloc >
+    bool operator<( const ft::deque<T,Alloc>& lhs,
+                   const ft::deque<T,Alloc>& rhs ) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template< class T, class Alloc >
+    bool operator>( const ft::deque<T,Alloc>& lhs,
+                   const ft::deque<T,Alloc>& rhs ) { return rhs < lhs; }
+
+    template< class T, class Alloc >
+    bool operator<=( const ft::deque<T,Alloc>& lhs,
+                    const ft::deque<T,Alloc>& rhs ) { return !(rhs < lhs); }
+
+    template< class T, class Alloc >
+    bool operator>=( const ft::deque<T,Alloc>& lhs,
+                    const ft::deque<T,Alloc>& rhs ) { return !(lhs < rhs); }
+
+    template< class T, class Alloc >
+    void swap( ft::deque<T,Alloc>& lhs,
+              ft::deque<T,Alloc>& rhs ) { lhs.swap(rhs); }
+}
+
+#endif//FT_CONTAINERS_DEQUE_HPP
@@ -0,0 +1,289 @@
+#ifndef FT_CONTAINERS_EXECUTION_HPP
+# define FT_CONTAINERS_EXECUTION_HPP
+# include <cstddef>
+# include <algorithm>
+# include <functional>
+# include "iterator.hpp"
+# include "sort.hpp"
+# include "thread_pool.hpp"
+# include "vector.hpp"
+
+namespace ft {
+    namespace execution {
+        struct sequenced_policy {};
+        struct parallel_policy {};
+
+        static const sequenced_policy seq = sequenced_policy();
+        static const parallel_policy par = parallel_policy();
+    }
+
+    // Smallest number of elements worth handing to another thread.
+    static const size_t parallel_min_grain = 4096;
+
+    template<class Body>
+    struct _parallel_range {
+        const Body* body;
+        size_t chunk;
+        size_t begin;
+        size_t end;
+
+        static void run(void* arg) {
+            _parallel_range* r = static_cast<_parallel_range*>(arg);
+            (*r->body)(r->chunk, r->begin, r->end);
+        }
+    };
+
+    // Calls body(chunk, begin, end) for consecutive chunks of [0, n) of grain
+    // elements each, on the pool, and waits for all of them. The calling
+    // thread runs the last chunk itself.
+    template<class Body>
+    void parallel_for(size_t n, size_t grain, const Body& body, thread_pool& pool = thread_pool::instance()) {
+        if (n == 0)
+            return ;
+        if (grain == 0)
+            grain = 1;
+        size_t chunks = (n + grain - 1) / grain;
+        if (chunks == 1) {
+            body(0, 0, n);
+            return ;
+        }
+        typedef _parallel_range<Body> range;
+        ft::vector<range> ranges;
+        ranges.reserve(chunks);
+        for (size_t i = 0; i < chunks; ++i) {
+            range r;
+            r.body = &body;
+            r.chunk = i;
+            r.begin = i * grain;
+            r.end = std::min(n, r.begin + grain);
+            ranges.push_back(r);
+        }
+        task_group group(pool);
+        for (size_t i = 0; i + 1 < chunks; ++i)
+            group.run(&range::run, &ranges[i]);
+        try {
+            range::run(&ranges[chunks - 1]);
+        }
+        catch (...) {
+            group.wait();
+            throw;
+        }
+        group.wait();
+    }
+
+    // Splits n elements into about eight chunks per worker, but never into
+    // chunks smaller than parallel_min_grain.
+    inline size_t parallel_grain(size_t n, thread_pool& pool = thread_pool::instance()) {
+        size_t grain = n / (pool.size() * 8);
+        return grain < parallel_min_grain ? parallel_min_grain : grain;
+    }
+
+    template<class RandomIt, class UnaryFunction>
+    struct _for_each_body {
+        RandomIt first;
+        UnaryFunction* f;
+
+        void operator()(size_t, size_t begin, size_t end) const {
+            for (RandomIt it = first + begin, last = first + end; it != last; ++it)
+                (*f)(*it);
+        }
+    };
+
+    template<class RandomIt1, class RandomIt2, class UnaryOperation>
+    struct _transform_body {
+        RandomIt1 first;
+        RandomIt2 out;
+        UnaryOperation* op;
+
+        void operator()(size_t, size_t begin, size_t end) const {
+            RandomIt2 o = out + begin;
+            for (RandomIt1 it = first + begin, last = first + end; it != last; ++it, ++o)
+                *o = (*op)(*it);
+        }
+    };
+
+    template<class RandomIt1, class RandomIt2>
+    struct _copy_body {
+        RandomIt1 first;
+        RandomIt2 out;
+
+        void operator()(size_t, size_t begin, size_t end) const {
+            std::copy(first + begin, first + end, out + begin);
+        }
+    };
+
+    template<class RandomIt, class T, class BinaryOp>
+    struct _reduce_body {
+        RandomIt first;
+        BinaryOp* op;
+        T* partial;
+
+        void operator()(size_t chunk, size_t begin, size_t end) const {
+            RandomIt it = first + begin;
+            RandomIt last = first + end;
+            T acc = *it;
+            for (++it; it != last; ++it)
+                acc = (*op)(acc, *it);
+            partial[chunk] = acc;
+        }
+    };
+
+    template<class RandomIt, class Compare>
+    struct _sort_body {
+        RandomIt first;
+        const size_t* bounds;
+        Compare* comp;
+
+        void operator()(size_t chunk, size_t, size_t) const {
+            ft::sort(first + bounds[chunk], first + bounds[chunk + 1], *comp);
+        }
+    };
+
+    // Merges run pairs (bounds[2i], bounds[2i+1], bounds[2i+2]).
+    template<class RandomIt, class Compare>
+    struct _merge_body {
+        RandomIt first;
+        const size_t* bounds;
+        Compare* comp;
+
+        void operator()(size_t pair, size_t, size_t) const {
+            const size_t* b = bounds + 2 * pair;
+            std::inplace_merge(first + b[0], first + b[1], first + b[2], *comp);
+        }
+    };
+
+    template<class InputIt, class UnaryFunction>
+    void for_each(execution::sequenced_policy, InputIt first, InputIt last, UnaryFunction f) {
+        for (; first != last; ++first)
+            f(*first);
+    }
+
+    // The parallel overloads need random-access iterators, such as those of
+    // ft::vector. Function objects are shared by all threads and must be
+    // safe to call concurrently.
+    template<class RandomIt, class UnaryFunction>
+    void for_each(execution::parallel_policy, RandomIt first, RandomIt last, UnaryFunction f) {
+        size_t n = last - first;
+        _for_each_body<RandomIt, UnaryFunction> body;
+        body.first = first;
+        body.f = &f;
+        parallel_for(n, parallel_grain(n), body);
+    }
+
+    template<class InputIt, class OutputIt, class UnaryOperation>
+    OutputIt transform(execution::sequenced_policy, InputIt first, InputIt last, OutputIt out, UnaryOperation op) {
+        for (; first != last; ++first, ++out)
+            *out = op(*first);
+        return out;
+    }
+
+    template<class RandomIt1, class RandomIt2, class UnaryOperation>
+    RandomIt2 transform(execution::parallel_policy, RandomIt1 first, RandomIt1 last, RandomIt2 out, UnaryOperation op) {
+        size_t n = last - first;
+        _transform_body<RandomIt1, RandomIt2, UnaryOperation> body;
+        body.first = first;
+        body.out = out;
+        body.op = &op;
+        parallel_for(n, parallel_grain(n), body);
+        return out + n;
+    }
+
+    template<class InputIt, class OutputIt>
+    OutputIt copy(execution::sequenced_policy, InputIt first, InputIt last, OutputIt out) {
+        return std::copy(first, last, out);
+    }
+
+    template<class RandomIt1, class RandomIt2>
+    RandomIt2 copy(execution::parallel_policy, RandomIt1 first, RandomIt1 last, RandomIt2 out) {
+        size_t n = last - first;
+        _copy_body<RandomIt1, RandomIt2> body;
+        body.first = first;
+        body.out = out;
+        parallel_for(n, parallel_grain(n), body);
+        return out + n;
+    }
+
+    template<class InputIt, class T, class BinaryOp>
+    T reduce(execution::sequenced_policy, InputIt first, InputIt last, T init, BinaryOp op) {
+        for (; first != last; ++first)
+            init = op(init, *first);
+        return init;
+    }
+
+    // op must be associative: chunks are folded separately and the partial
+    // results combined in order.
+    template<class RandomIt, class T, class BinaryOp>
+    T reduce(execution::parallel_policy, RandomIt first, RandomIt last, T init, BinaryOp op) {
+        size_t n = last - first;
+        if (n == 0)
+            return init;
+        size_t grain = parallel_grain(n);
+        ft::vector<T> partial((n + grain - 1) / grain, init);
+        _reduce_body<RandomIt, T, BinaryOp> body;
+        body.first = first;
+        body.op = &op;
+        body.partial = partial.data();
+        parallel_for(n, grain, body);
+        for (size_t i = 0; i < partial.size(); ++i)
+            init = op(init, partial[i]);
+        return init;
+    }
+
+    template<class Policy, class InputIt, class T>
+    T reduce(Policy policy, InputIt first, InputIt last, T init) {
+        return ft::reduce(policy, first, last, init, std::plus<T>());
+    }
+
+    template<class RandomIt, class Compare>
+    void sort(execution::sequenced_policy, RandomIt first, RandomIt last, Compare comp) {
+        ft::sort(first, last, comp);
+    }
+
+    // Sorts one run per worker in parallel, then merges neighbouring runs
+    // pairwise, halving their number each round.
+    template<class RandomIt, class Compare>
+    void sort(execution::parallel_policy, RandomIt first, RandomIt last, Compare comp) {
+        thread_pool& pool = thread_pool::instance();
+        size_t n = last - first;
+        size_t runs = std::min(pool.size(), n / parallel_min_grain);
+        if (runs < 2) {
+            ft::sort(first, last, comp);
+            return ;
+        }
+        ft::vector<size_t> bounds;
+        bounds.reserve(runs + 1);
+        for (size_t i = 0; i <= runs; ++i)
+            bounds.push_back(n / runs * i + (i == runs ? n % runs : 0));
+        _sort_body<RandomIt, Compare> sorter;
+        sorter.first = first;
+        sorter.bounds = bounds.data();
+        sorter.comp = &comp;
+        parallel_for(runs, 1, sorter, pool);
+        while (bounds.size() > 2) {
+            _merge_body<RandomIt, Compare> merger;
+            merger.first = first;
+            merger.bounds = bounds.data();
+            merger.comp = &comp;
+            parallel_for((bounds.size() - 1) / 2, 1, merger, pool);
+            ft::vector<size_t> next;
+            next.reserve(bounds.size() / 2 + 1);
+            for (size_t i = 0; i < bounds.size(); i += 2)
+                next.push_back(bounds[i]);
+            if (next.back() != n)
+                next.push_back(n);
+            bounds.swap(next);
+        }
+    }
+
+    template<class RandomIt>
+    void sort(execution::sequenced_policy policy, RandomIt first, RandomIt last) {
+        ft::sort(policy, first, last, std::less<typename ft::iterator_traits<RandomIt>::value_type>());
+    }
+
+    template<class RandomIt>
+    void sort(execution::parallel_policy policy, RandomIt first, RandomIt last) {
+        ft::sort(policy, first, last, std::less<typename ft::iterator_traits<RandomIt>::value_type>());
+    }
+}
+
+#endif//FT_CONTAINERS_EXECUTION_HPP
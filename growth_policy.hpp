@@ -0,0 +1,40 @@
+#ifndef FT_CONTAINERS_GROWTH_POLICY_HPP
+# define FT_CONTAINERS_GROWTH_POLICY_HPP
+# include <cstddef>
+# include "memory.hpp"
+
+namespace ft {
+    // A growth policy maps the current capacity and the number of elements
+    // that must fit to the capacity of the next buffer.
+
+    struct growth_double {
+        static size_t next_capacity(size_t capacity, size_t required, size_t) {
+            size_t grown = capacity == 0 ? 1 : 2 * capacity;
+            return grown < required ? required : grown;
+        }
+    };
+
+    struct growth_golden {
+        static size_t next_capacity(size_t capacity, size_t required, size_t) {
+            size_t grown = capacity + capacity / 2;
+            if (grown <= capacity)
+                grown = capacity + 1;
+            return grown < required ? required : grown;
+        }
+    };
+
+    // Adds IncrementBytes per step and rounds the buffer up to whole pages,
+    // so the waste after a spike is bounded by one increment.
+    template<size_t IncrementBytes = 64 * 4096>
+    struct growth_fixed {
+        static size_t next_capacity(size_t capacity, size_t required, size_t elem_size) {
+            size_t bytes = capacity * elem_size + IncrementBytes;
+            if (bytes < required * elem_size)
+                bytes = required * elem_size;
+            size_t grown = round_to_pages(bytes) / elem_size;
+            return grown > capacity ? grown : capacity + 1;
+        }
+    };
+}
+
+#endif//FT_CONTAINERS_GROWTH_POLICY_HPP
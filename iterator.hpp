@@ -1,6 +1,7 @@
 #ifndef FT_CONTAINERS_ITERATOR_HPP
 # define FT_CONTAINERS_ITERATOR_HPP
 # include <iterator>
+# include <cstddef>
 
 namespace ft {
     template <class Iter>
@@ -0,0 +1,104 @@
+#ifndef FT_CONTAINERS_KEY_PREFIX_HPP
+# define FT_CONTAINERS_KEY_PREFIX_HPP
+# include <cstddef>
+# include <cstring>
+# include <string>
+# include <functional>
+# include <stdint.h>
+
+namespace ft {
+    // Key prefixes that tree nodes can keep next to their key, so that most
+    // comparisons on the way down are settled without reading the key
+    // itself, e.g. without following a std::string to its heap buffer.
+    //
+    // Traits for a key type and comparator that set enabled provide a
+    // prefix_type with operator<, and prefix(key), such that
+    //
+    //     prefix(a) < prefix(b)  implies  comp(a, b)
+    //
+    // plus compare(a, b), a three-way comparison agreeing with comp that is
+    // only used on keys with equal prefixes, so it may skip what the prefix
+    // covers. Specialize this for other key types. ft::map and ft::set use
+    // no_key_prefix unless given these traits, e.g.
+    //
+    //     ft::set<std::string, std::less<std::string>, std::allocator<std::string>,
+    //             ft::key_prefix_traits<std::string, std::less<std::string> > >
+    template<class Key, class Compare>
+    struct key_prefix_traits {
+        static const bool enabled = false;
+    };
+
+    struct no_key_prefix {
+        static const bool enabled = false;
+    };
+
+    // The first 16 bytes of a string as two big-endian words, padded with
+    // zeros, which orders like the strings up to there.
+    struct string_prefix {
+        uint64_t high;
+        uint64_t low;
+
+        bool operator<( const string_prefix& other ) const {
+            return high < other.high || (high == other.high && low < other.low);
+        }
+    };
+
+    template<>
+    struct key_prefix_traits<std::string, std::less<std::string> > {
+        static const bool enabled = true;
+        typedef string_prefix prefix_type;
+
+        static prefix_type prefix( const std::string& key ) {
+            unsigned char bytes[16] = {0};
+            std::memcpy(bytes, key.data(), key.size() < 16 ? key.size() : 16);
+            prefix_type p;
+            p.high = _load(bytes);
+            p.low = _load(bytes + 8);
+            return p;
+        }
+
+        // Strings of 16 bytes or more with equal prefixes start alike.
+        static int compare( const std::string& a, const std::string& b ) {
+            if (a.size() < 16 || b.size() < 16)
+                return a.compare(b);
+            return a.compare(16, std::string::npos, b, 16, std::string::npos);
+        }
+
+    private:
+        static uint64_t _load( const unsigned char* bytes ) {
+            uint64_t word = 0;
+            for (int i = 0; i < 8; ++i)
+                word = word << 8 | bytes[i];
+            return word;
+        }
+    };
+
+    // The KeyPrefix arguments ft::map and ft::set accept for a Key and
+    // Compare: traits made for another comparator would order keys by the
+    // wrong rule.
+    template<class KeyPrefix, class Key, class Compare>
+    struct key_prefix_fits { static const bool value = false; };
+
+    template<class Key, class Compare>
+    struct key_prefix_fits<no_key_prefix, Key, Compare> { static const bool value = true; };
+
+    template<class Key, class Compare>
+    struct key_prefix_fits<key_prefix_traits<Key, Compare>, Key, Compare> { static const bool value = true; };
+
+    // Adapts key traits to the ft::pair<const Key, T> elements of a map.
+    template<class Pair, class KeyPrefix, bool Enabled = KeyPrefix::enabled>
+    struct pair_key_prefix {
+        static const bool enabled = false;
+    };
+
+    template<class Pair, class KeyPrefix>
+    struct pair_key_prefix<Pair, KeyPrefix, true> {
+        static const bool enabled = true;
+        typedef typename KeyPrefix::prefix_type prefix_type;
+
+        static prefix_type prefix( const Pair& value ) { return KeyPrefix::prefix(value.first); }
+        static int compare( const Pair& a, const Pair& b ) { return KeyPrefix::compare(a.first, b.first); }
+    };
+}
+
+#endif//FT_CONTAINERS_KEY_PREFIX_HPP
@@ -0,0 +1,242 @@
+#ifndef FT_CONTAINERS_LATENCY_HPP
+# define FT_CONTAINERS_LATENCY_HPP
+# include <cstddef>
+# include <climits>
+# include <ostream>
+# include <stdint.h>
+# include <time.h>
+
+// Build with -DFT_CONTAINERS_LATENCY=1 to time the hot paths of ft::vector,
+// ft::map and ft::set. Otherwise FT_LATENCY_SCOPE expands to nothing and the
+// containers compile exactly as before.
+# ifndef FT_CONTAINERS_LATENCY
+#  define FT_CONTAINERS_LATENCY 0
+# endif
+
+# if FT_CONTAINERS_LATENCY
+#  define FT_LATENCY_SCOPE(op) ft::latency_timer _ft_latency_timer(op)
+# else
+#  define FT_LATENCY_SCOPE(op)
+# endif
+
+namespace ft {
+    // Time stamp counter ticks on x86, where reading it costs a few dozen
+    // cycles; CLOCK_MONOTONIC nanoseconds elsewhere.
+    struct latency_clock {
+        static uint64_t now() {
+# if defined(__i386__) || defined(__x86_64__)
+            return __builtin_ia32_rdtsc();
+# else
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+# endif
+        }
+
+        static const char* unit() {
+# if defined(__i386__) || defined(__x86_64__)
+            return "cycles";
+# else
+            return "ns";
+# endif
+        }
+    };
+
+    // HdrHistogram-style buckets: values below 2 * sub_buckets are exact,
+    // and above that every power of two is split into sub_buckets equal
+    // buckets, so any value is known to within 1/16 of itself over the whole
+    // 64-bit range in under a thousand counters. Updates are atomic, so one
+    // histogram can be fed from several threads.
+    class latency_histogram {
+    public:
+        static const unsigned sub_bucket_bits = 4;
+        static const uint64_t sub_buckets = uint64_t(1) << sub_bucket_bits;
+        static const size_t bucket_count = (sizeof(uint64_t) * CHAR_BIT - sub_bucket_bits + 1) * sub_buckets;
+
+        latency_histogram() { reset(); }
+
+        void record( uint64_t value ) {
+            __atomic_add_fetch(&_counts[bucket_of(value)], 1, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&_count, 1, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&_sum, value, __ATOMIC_RELAXED);
+            uint64_t seen = __atomic_load_n(&_min, __ATOMIC_RELAXED);
+            while (value < seen && !__atomic_compare_exchange_n(&_min, &seen, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                ;
+            seen = __atomic_load_n(&_max, __ATOMIC_RELAXED);
+            while (value > seen && !__atomic_compare_exchange_n(&_max, &seen, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                ;
+        }
+
+        void reset() {
+            for (size_t i = 0; i < bucket_count; ++i)
+                _counts[i] = 0;
+            _count = 0;
+            _sum = 0;
+            _min = ~uint64_t(0);
+            _max = 0;
+        }
+
+        uint64_t count() const { return _load(_count); }
+        uint64_t min() const { return count() == 0 ? 0 : _load(_min); }
+        uint64_t max() const { return _load(_max); }
+        double mean() const { return count() == 0 ? 0.0 : static_cast<double>(_load(_sum)) / count(); }
+        uint64_t bucket(size_t index) const { return _load(_counts[index]); }
+
+        // The largest value that may fall in the bucket holding the given
+        // percentile (0-100), capped at max().
+        uint64_t percentile( double p ) const {
+            uint64_t total = count();
+            if (total == 0)
+                return 0;
+            uint64_t rank = static_cast<uint64_t>(p / 100.0 * total + 0.5);
+            if (rank == 0)
+                rank = 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < bucket_count; ++i) {
+                seen += bucket(i);
+                if (seen >= rank) {
+                    uint64_t highest = bucket_upper(i);
+                    return highest < max() ? highest : max();
+                }
+            }
+            return max();
+        }
+
+        static size_t bucket_of( uint64_t value ) {
+            if (value < 2 * sub_buckets)
+                return static_cast<size_t>(value);
+            unsigned shift = sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(value) - sub_bucket_bits;
+            return static_cast<size_t>((shift + 1) * sub_buckets + (value >> shift) - sub_buckets);
+        }
+
+        static uint64_t bucket_lower( size_t index ) {
+            if (index < 2 * sub_buckets)
+                return index;
+            unsigned shift = static_cast<unsigned>(index / sub_buckets - 1);
+            return (sub_buckets + index % sub_buckets) << shift;
+        }
+
+        static uint64_t bucket_upper( size_t index ) {
+            if (index < 2 * sub_buckets)
+                return index;
+            unsigned shift = static_cast<unsigned>(index / sub_buckets - 1);
+            return bucket_lower(index) + ((uint64_t(1) << shift) - 1);
+        }
+
+        // One line of count, min, mean, percentiles and max.
+        void print( std::ostream& os ) const {
+            os << "count " << count() << " min " << min() << " mean " << static_cast<uint64_t>(mean())
+               << " p50 " << percentile(50) << " p90 " << percentile(90) << " p99 " << percentile(99)
+               << " p99.9 " << percentile(99.9) << " max " << max();
+        }
+
+        // The same numbers as a JSON object, plus the non-empty buckets as
+        // [lowest, highest, count] triples.
+        void print_json( std::ostream& os ) const {
+            os << "{\"count\":" << count() << ",\"min\":" << min() << ",\"mean\":" << mean()
+               << ",\"p50\":" << percentile(50) << ",\"p90\":" << percentile(90) << ",\"p99\":" << percentile(99)
+               << ",\"p99.9\":" << percentile(99.9) << ",\"max\":" << max() << ",\"buckets\":[";
+            const char* sep = "";
+            for (size_t i = 0; i < bucket_count; ++i) {
+                if (bucket(i) == 0)
+                    continue;
+                os << sep << "[" << bucket_lower(i) << "," << bucket_upper(i) << "," << bucket(i) << "]";
+                sep = ",";
+            }
+            os << "]}";
+        }
+
+    private:
+        uint64_t _counts[bucket_count];
+        uint64_t _count;
+        uint64_t _sum;
+        uint64_t _min;
+        uint64_t _max;
+
+        latency_histogram( const latency_histogram& );
+        latency_histogram& operator=( const latency_histogram& );
+
+        static uint64_t _load( const uint64_t& counter ) { return __atomic_load_n(&counter, __ATOMIC_RELAXED); }
+    };
+
+    // The timed operations. Calls that delegate to another timed one are
+    // counted under both, e.g. a push_back that grows also shows up under
+    // vector::reserve, and map::erase by key under map::find.
+    enum latency_op {
+        latency_vector_push_back,   // push_back, emplace_back
+        latency_vector_insert,      // insert, but not emplace, which push_back uses
+        latency_vector_erase,
+        latency_vector_reserve,     // explicit, or growing for push_back, resize and assign
+        latency_map_insert,         // insert, emplace, operator[] on a new key
+        latency_map_erase,
+        latency_map_find,
+        latency_set_insert,
+        latency_set_erase,
+        latency_set_find,
+        latency_op_count
+    };
+
+    inline const char* latency_op_name( latency_op op ) {
+        static const char* const names[latency_op_count] = {
+            "vector::push_back", "vector::insert", "vector::erase", "vector::reserve",
+            "map::insert", "map::erase", "map::find",
+            "set::insert", "set::erase", "set::find"
+        };
+        return names[op];
+    }
+
+    // The process-wide histogram of one operation, shared by every container
+    // instance.
+    inline latency_histogram& latency_of( latency_op op ) {
+        static latency_histogram histograms[latency_op_count];
+        return histograms[op];
+    }
+
+    inline void latency_reset() {
+        for (int op = 0; op < latency_op_count; ++op)
+            latency_of(static_cast<latency_op>(op)).reset();
+    }
+
+    // One line per operation that was timed at least once.
+    inline void latency_report( std::ostream& os ) {
+        for (int i = 0; i < latency_op_count; ++i) {
+            latency_op op = static_cast<latency_op>(i);
+            if (latency_of(op).count() == 0)
+                continue;
+            os << latency_op_name(op) << " (" << latency_clock::unit() << "): ";
+            latency_of(op).print(os);
+            os << "\n";
+        }
+    }
+
+    inline void latency_report_json( std::ostream& os ) {
+        os << "{\"unit\":\"" << latency_clock::unit() << "\",\"operations\":{";
+        const char* sep = "";
+        for (int i = 0; i < latency_op_count; ++i) {
+            latency_op op = static_cast<latency_op>(i);
+            if (latency_of(op).count() == 0)
+                continue;
+            os << sep << "\"" << latency_op_name(op) << "\":";
+            latency_of(op).print_json(os);
+            sep = ",";
+        }
+        os << "}}\n";
+    }
+
+    // Records the time from its construction to its destruction, so a scope
+    // is timed on every way out of it, exceptions included.
+    class latency_timer {
+    public:
+        explicit latency_timer( latency_op op ): _op(op), _start(latency_clock::now()) {}
+        ~latency_timer() { latency_of(_op).record(latency_clock::now() - _start); }
+
+    private:
+        latency_op _op;
+        uint64_t _start;
+
+        latency_timer( const latency_timer& );
+        latency_timer& operator=( const latency_timer& );
+    };
+}
+
+#endif//FT_CONTAINERS_LATENCY_HPP
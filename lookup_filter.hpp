@@ -0,0 +1,192 @@
+#ifndef FT_CONTAINERS_LOOKUP_FILTER_HPP
+# define FT_CONTAINERS_LOOKUP_FILTER_HPP
+# include <cstddef>
+# include <cstring>
+# include <algorithm>
+# include <string>
+# include <new>
+# include <stdint.h>
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+namespace ft {
+    // The splitmix64 finalizer, which spreads every input bit over the
+    // whole word.
+    inline uint64_t lookup_mix( uint64_t x ) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    // Hashes for the lookup filter of ft::map and ft::set, given for integral
+    // keys and std::string. Specialize it for other key types, or hand a
+    // function to enable_lookup_filter(). Keys the comparator of the
+    // container holds equivalent must hash alike, so e.g. a case-insensitive
+    // comparator needs a case-insensitive hash.
+    template<class Key, bool Integral = is_integral<Key>::value>
+    struct lookup_hash;
+
+    template<class Key>
+    struct lookup_hash<Key, true> {
+        static uint64_t hash( const Key& key ) { return lookup_mix(static_cast<uint64_t>(key)); }
+    };
+
+    template<>
+    struct lookup_hash<std::string, false> {
+        static uint64_t hash( const std::string& key ) {
+            const char* bytes = key.data();
+            size_t size = key.size();
+            uint64_t h = lookup_mix(size);
+            for (; size >= 8; bytes += 8, size -= 8) {
+                uint64_t word;
+                std::memcpy(&word, bytes, 8);
+                h = lookup_mix(h ^ word);
+            }
+            if (size != 0) {
+                uint64_t word = 0;
+                std::memcpy(&word, bytes, size);
+                h = lookup_mix(h ^ word);
+            }
+            return h;
+        }
+    };
+
+    // A blocked counting Bloom filter: every key sets probes 4-bit counters
+    // inside one cache line, so a lookup that misses reads one line instead
+    // of walking the tree. Counters are incremented on insert and
+    // decremented on erase; one that reaches 15 sticks there, which can only
+    // cost false positives, never a false negative.
+    template<class Key>
+    class lookup_filter {
+    public:
+        typedef uint64_t (*hasher)( const Key& );
+
+        static const size_t counters_per_block = 128;
+        static const size_t counters_per_key = 12;
+        static const unsigned probes = 4;
+
+        lookup_filter(): _blocks(NULL), _block_count(0), _hash(NULL) {}
+
+        lookup_filter( const lookup_filter& other ): _blocks(NULL), _block_count(0), _hash(other._hash) {
+            if (other.enabled()) {
+                _blocks = _allocate(other._block_count);
+                _block_count = other._block_count;
+                std::memcpy(_blocks, other._blocks, _block_count * sizeof(block));
+            }
+        }
+
+        lookup_filter& operator=( const lookup_filter& other ) {
+            if (this != &other) {
+                lookup_filter copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        ~lookup_filter() { disable(); }
+
+        bool enabled() const { return _blocks != NULL; }
+        hasher hash_function() const { return _hash; }
+        size_t capacity() const { return _block_count * counters_per_block / counters_per_key; }
+        size_t memory_usage() const { return _block_count * sizeof(block); }
+
+        // Drops the counters and sizes the filter for capacity keys.
+        void enable( hasher hash, size_t capacity ) {
+            size_t count = (capacity * counters_per_key + counters_per_block - 1) / counters_per_block;
+            block* blocks = _allocate(count == 0 ? 1 : count);
+            disable();
+            _blocks = blocks;
+            _block_count = count == 0 ? 1 : count;
+            _hash = hash;
+        }
+
+        void disable() {
+            if (_blocks != NULL)
+                aligned_allocator<block, cache_line_size>().deallocate(_blocks, _block_count);
+            _blocks = NULL;
+            _block_count = 0;
+        }
+
+        void clear() {
+            if (enabled())
+                std::memset(_blocks, 0, _block_count * sizeof(block));
+        }
+
+        void insert( const Key& key ) {
+            uint64_t h = _hash(key);
+            uint64_t* words = _block_of(h).words;
+            for (unsigned i = 0; i < probes; ++i, h >>= 7) {
+                unsigned shift = (h & 15) * 4;
+                uint64_t& word = words[h >> 4 & 7];
+                if ((word >> shift & 15) != 15)
+                    word += uint64_t(1) << shift;
+            }
+        }
+
+        void erase( const Key& key ) {
+            uint64_t h = _hash(key);
+            uint64_t* words = _block_of(h).words;
+            for (unsigned i = 0; i < probes; ++i, h >>= 7) {
+                unsigned shift = (h & 15) * 4;
+                uint64_t& word = words[h >> 4 & 7];
+                uint64_t counter = word >> shift & 15;
+                if (counter != 15 && counter != 0)
+                    word -= uint64_t(1) << shift;
+            }
+        }
+
+        // False only if the key was never inserted, or erased since; always
+        // true while the filter is off.
+        bool may_contain( const Key& key ) const {
+            if (!enabled())
+                return true;
+            uint64_t h = _hash(key);
+            const uint64_t* words = _block_of(h).words;
+            for (unsigned i = 0; i < probes; ++i, h >>= 7)
+                if ((words[h >> 4 & 7] >> ((h & 15) * 4) & 15) == 0)
+                    return false;
+            return true;
+        }
+
+        void swap( lookup_filter& other ) {
+            std::swap(_blocks, other._blocks);
+            std::swap(_block_count, other._block_count);
+            std::swap(_hash, other._hash);
+        }
+
+    private:
+        struct block {
+            uint64_t words[counters_per_block / 16];
+        };
+
+        block* _blocks;
+        size_t _block_count;
+        hasher _hash;
+
+        static block* _allocate( size_t count ) {
+            block* blocks = aligned_allocator<block, cache_line_size>().allocate(count);
+            std::memset(blocks, 0, count * sizeof(block));
+            return blocks;
+        }
+
+        // The high half of the hash picks the block, the low bits the
+        // counters inside it.
+        block& _block_of( uint64_t h ) const {
+            return _blocks[static_cast<size_t>((h >> 32) * _block_count >> 32)];
+        }
+    };
+
+    template<class Key>
+    const size_t lookup_filter<Key>::counters_per_block;
+
+    template<class Key>
+    const size_t lookup_filter<Key>::counters_per_key;
+
+    template<class Key>
+    const unsigned lookup_filter<Key>::probes;
+}
+
+#endif//FT_CONTAINERS_LOOKUP_FILTER_HPP
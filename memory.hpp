@@ -0,0 +1,334 @@
+#ifndef FT_CONTAINERS_MEMORY_HPP
+# define FT_CONTAINERS_MEMORY_HPP
+# include <cstddef>
+# include <cstdlib>
+# include <cstring>
+# include <new>
+# include <limits>
+# include <sys/mman.h>
+# include <unistd.h>
+# include <sched.h>
+# include "type_traits.hpp"
+
+namespace ft {
+    // Allocators that can resize a block in place, keeping its contents, set
+    // this to let containers of trivially relocatable types grow without a
+    // copy. They must provide reallocate(p, old_n, new_n).
+    template<class Alloc>
+    struct is_reallocatable_allocator: false_type {};
+
+    inline size_t page_size() {
+        static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    inline size_t round_to_pages(size_t bytes) {
+        size_t page = page_size();
+        return (bytes + page - 1) / page * page;
+    }
+
+    // What a container's memory_usage() reports, in bytes, for the memory it
+    // holds on behalf of its elements. payload counts sizeof(value_type) per
+    // element; anything the elements own themselves is not followed, and
+    // neither is the container object itself.
+    struct memory_footprint {
+        size_t payload;
+        size_t node_overhead;       // links, colours, block maps
+        size_t sentinel;            // nil and header nodes
+        size_t unused_capacity;     // allocated slots without an element
+
+        memory_footprint(): payload(0), node_overhead(0), sentinel(0), unused_capacity(0) {}
+
+        size_t overhead() const { return node_overhead + sentinel + unused_capacity; }
+        size_t total() const { return payload + overhead(); }
+
+        memory_footprint& operator+=(const memory_footprint& other) {
+            payload += other.payload;
+            node_overhead += other.node_overhead;
+            sentinel += other.sentinel;
+            unused_capacity += other.unused_capacity;
+            return *this;
+        }
+    };
+
+    // Assumed cache line size, for keeping data written by different threads
+    // on separate lines.
+    static const size_t cache_line_size = 64;
+
+    // Spin-wait hint for the busy loops of the lock-free containers.
+    inline void cpu_relax() {
+# if defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+# elif defined(__aarch64__)
+        __asm__ __volatile__("yield");
+# endif
+    }
+
+    // Exponential backoff: spins twice as long on each call, then starts
+    // yielding the CPU once spinning no longer pays off.
+    class spin_backoff {
+    public:
+        spin_backoff(): _spins(1) {}
+
+        void pause() {
+            if (_spins <= _max_spins) {
+                for (unsigned i = 0; i < _spins; ++i)
+                    cpu_relax();
+                _spins <<= 1;
+            }
+            else
+                sched_yield();
+        }
+
+        void reset() { _spins = 1; }
+
+    private:
+        static const unsigned _max_spins = 64;
+        unsigned _spins;
+    };
+
+    // Typedefs and element handling shared by the allocators below; they
+    // only differ in where the raw memory comes from.
+    template<class T>
+    class basic_allocator {
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        pointer address(reference x) const { return &x; }
+        const_pointer address(const_reference x) const { return &x; }
+
+        size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+        void construct(pointer p, const T& value) { new (static_cast<void*>(p)) T(value); }
+# if FT_CONTAINERS_CXX11
+        template<class U, class... Args>
+        void construct(U* p, Args&&... args) { new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+# endif
+        void destroy(pointer p) { p->~T(); }
+    };
+
+    // malloc/realloc for medium blocks, anonymous mappings grown with mremap
+    // for blocks of at least mmap_threshold bytes, so a huge buffer can
+    // usually be extended by remapping its pages instead of copying them.
+    template<class T>
+    class realloc_allocator: public basic_allocator<T> {
+    public:
+        typedef typename basic_allocator<T>::pointer pointer;
+        typedef typename basic_allocator<T>::size_type size_type;
+
+        template<class U>
+        struct rebind { typedef realloc_allocator<U> other; };
+
+        static const size_type mmap_threshold = size_type(32) << 20;
+
+        realloc_allocator() {}
+        realloc_allocator(const realloc_allocator&) {}
+        template<class U>
+        realloc_allocator(const realloc_allocator<U>&) {}
+        ~realloc_allocator() {}
+
+        realloc_allocator& operator=(const realloc_allocator&) { return *this; }
+
+        pointer allocate(size_type n, const void* = 0) {
+            if (n == 0)
+                return NULL;
+            if (n > this->max_size())
+                throw std::bad_alloc();
+            size_type bytes = n * sizeof(T);
+            void* p;
+            if (bytes >= mmap_threshold) {
+                p = mmap(NULL, round_to_pages(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED)
+                    throw std::bad_alloc();
+            }
+            else if ((p = std::malloc(bytes)) == NULL)
+                throw std::bad_alloc();
+            return static_cast<pointer>(p);
+        }
+
+        void deallocate(pointer p, size_type n) {
+            if (p == NULL)
+                return ;
+            size_type bytes = n * sizeof(T);
+            if (bytes >= mmap_threshold)
+                munmap(p, round_to_pages(bytes));
+            else
+                std::free(p);
+        }
+
+        // Resizes the block keeping the first min(old_n, new_n) elements
+        // bitwise; only valid for trivially relocatable contents.
+        pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+            if (p == NULL)
+                return allocate(new_n);
+            if (new_n > this->max_size())
+                throw std::bad_alloc();
+            size_type old_bytes = old_n * sizeof(T);
+            size_type new_bytes = new_n * sizeof(T);
+            bool old_mapped = old_bytes >= mmap_threshold;
+            bool new_mapped = new_bytes >= mmap_threshold;
+            if (!old_mapped && !new_mapped && new_n != 0) {
+                void* q = std::realloc(p, new_bytes);
+                if (q == NULL)
+                    throw std::bad_alloc();
+                return static_cast<pointer>(q);
+            }
+# ifdef MREMAP_MAYMOVE
+            if (old_mapped && new_mapped) {
+                void* q = mremap(p, round_to_pages(old_bytes), round_to_pages(new_bytes), MREMAP_MAYMOVE);
+                if (q == MAP_FAILED)
+                    throw std::bad_alloc();
+                return static_cast<pointer>(q);
+            }
+# endif
+            pointer q = allocate(new_n);
+            if (q != NULL)
+                std::memcpy(static_cast<void*>(q), static_cast<const void*>(p), (old_n < new_n ? old_n : new_n) * sizeof(T));
+            deallocate(p, old_n);
+            return q;
+        }
+    };
+
+    template<class T>
+    const typename realloc_allocator<T>::size_type realloc_allocator<T>::mmap_threshold;
+
+    template<class T, class U>
+    bool operator==(const realloc_allocator<T>&, const realloc_allocator<U>&) { return true; }
+
+    template<class T, class U>
+    bool operator!=(const realloc_allocator<T>&, const realloc_allocator<U>&) { return false; }
+
+    template<class T>
+    struct is_reallocatable_allocator<realloc_allocator<T> >: true_type {};
+
+    // Every block starts on an Align-byte boundary, e.g. 64 for AVX-512 loads
+    // or a cache line per tree node.
+    template<class T, size_t Align = 64>
+    class aligned_allocator: public basic_allocator<T> {
+    public:
+        typedef typename basic_allocator<T>::pointer pointer;
+        typedef typename basic_allocator<T>::size_type size_type;
+
+        template<class U>
+        struct rebind { typedef aligned_allocator<U, Align> other; };
+
+        static const size_type alignment = Align < sizeof(void*) ? sizeof(void*) : Align;
+
+        aligned_allocator() {}
+        aligned_allocator(const aligned_allocator&) {}
+        template<class U>
+        aligned_allocator(const aligned_allocator<U, Align>&) {}
+        ~aligned_allocator() {}
+
+        aligned_allocator& operator=(const aligned_allocator&) { return *this; }
+
+        pointer allocate(size_type n, const void* = 0) {
+            typedef char alignment_must_be_a_power_of_two[(Align & (Align - 1)) == 0 ? 1 : -1];
+            (void)sizeof(alignment_must_be_a_power_of_two);
+            if (n == 0)
+                return NULL;
+            if (n > this->max_size())
+                throw std::bad_alloc();
+            void* p;
+            if (posix_memalign(&p, alignment, n * sizeof(T)) != 0)
+                throw std::bad_alloc();
+            return static_cast<pointer>(p);
+        }
+
+        void deallocate(pointer p, size_type) {
+            std::free(p);
+        }
+    };
+
+    template<class T, size_t Align>
+    const typename aligned_allocator<T, Align>::size_type aligned_allocator<T, Align>::alignment;
+
+    template<class T, class U, size_t Align>
+    bool operator==(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) { return true; }
+
+    template<class T, class U, size_t Align>
+    bool operator!=(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) { return false; }
+
+    // Blocks of at least one huge page are mapped on a huge page boundary and
+    // marked MADV_HUGEPAGE so transparent huge pages can back them; smaller
+    // blocks, such as single tree nodes, come from malloc.
+    template<class T>
+    class hugepage_allocator: public basic_allocator<T> {
+    public:
+        typedef typename basic_allocator<T>::pointer pointer;
+        typedef typename basic_allocator<T>::size_type size_type;
+
+        template<class U>
+        struct rebind { typedef hugepage_allocator<U> other; };
+
+        static const size_type huge_page_size = size_type(2) << 20;
+
+        hugepage_allocator() {}
+        hugepage_allocator(const hugepage_allocator&) {}
+        template<class U>
+        hugepage_allocator(const hugepage_allocator<U>&) {}
+        ~hugepage_allocator() {}
+
+        hugepage_allocator& operator=(const hugepage_allocator&) { return *this; }
+
+        pointer allocate(size_type n, const void* = 0) {
+            if (n == 0)
+                return NULL;
+            if (n > this->max_size())
+                throw std::bad_alloc();
+            size_type bytes = n * sizeof(T);
+            if (bytes < huge_page_size) {
+                void* p = std::malloc(bytes);
+                if (p == NULL)
+                    throw std::bad_alloc();
+                return static_cast<pointer>(p);
+            }
+            size_type length = _round(bytes);
+            char* raw = static_cast<char*>(mmap(NULL, length + huge_page_size, PROT_READ | PROT_WRITE,
+                                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+            if (raw == MAP_FAILED)
+                throw std::bad_alloc();
+            char* p = raw + (huge_page_size - reinterpret_cast<size_t>(raw) % huge_page_size) % huge_page_size;
+            if (p != raw)
+                munmap(raw, p - raw);
+            if (p + length != raw + length + huge_page_size)
+                munmap(p + length, raw + huge_page_size - p);
+# ifdef MADV_HUGEPAGE
+            madvise(p, length, MADV_HUGEPAGE);
+# endif
+            return reinterpret_cast<pointer>(p);
+        }
+
+        void deallocate(pointer p, size_type n) {
+            if (p == NULL)
+                return ;
+            size_type bytes = n * sizeof(T);
+            if (bytes < huge_page_size)
+                std::free(p);
+            else
+                munmap(p, _round(bytes));
+        }
+
+    private:
+        static size_type _round(size_type bytes) {
+            return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+        }
+    };
+
+    template<class T>
+    const typename hugepage_allocator<T>::size_type hugepage_allocator<T>::huge_page_size;
+
+    template<class T, class U>
+    bool operator==(const hugepage_allocator<T>&, const hugepage_allocator<U>&) { return true; }
+
+    template<class T, class U>
+    bool operator!=(const hugepage_allocator<T>&, const hugepage_allocator<U>&) { return false; }
+}
+
+#endif//FT_CONTAINERS_MEMORY_HPP
@@ -0,0 +1,447 @@
+#ifndef FT_CONTAINERS_MEMORY_RESOURCE_HPP
+# define FT_CONTAINERS_MEMORY_RESOURCE_HPP
+# include <cstddef>
+# include <cstdlib>
+# include <new>
+# include <limits>
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+namespace ft {
+    namespace pmr {
+        static const size_t max_align = __BIGGEST_ALIGNMENT__;
+
+        // Source of raw memory chosen at run time, so containers with
+        // different arenas still have the same type.
+        class memory_resource {
+        public:
+            virtual ~memory_resource() {}
+
+            void* allocate(size_t bytes, size_t alignment = max_align) { return do_allocate(bytes, alignment); }
+            void deallocate(void* p, size_t bytes, size_t alignment = max_align) { do_deallocate(p, bytes, alignment); }
+            bool is_equal(const memory_resource& other) const { return do_is_equal(other); }
+
+        protected:
+            virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+            virtual void do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+            virtual bool do_is_equal(const memory_resource& other) const { return this == &other; }
+        };
+
+        inline bool operator==(const memory_resource& lhs, const memory_resource& rhs) {
+            return &lhs == &rhs || lhs.is_equal(rhs);
+        }
+
+        inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs) { return !(lhs == rhs); }
+
+        // operator new, or posix_memalign beyond the default alignment.
+        class _new_delete_resource: public memory_resource {
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) {
+                if (alignment <= max_align)
+                    return ::operator new(bytes);
+                void* p;
+                if (posix_memalign(&p, alignment, bytes) != 0)
+                    throw std::bad_alloc();
+                return p;
+            }
+
+            void do_deallocate(void* p, size_t, size_t alignment) {
+                if (alignment <= max_align)
+                    ::operator delete(p);
+                else
+                    std::free(p);
+            }
+        };
+
+        // Throws std::bad_alloc on every allocation; an upstream for arenas
+        // that must never outgrow their initial buffer.
+        class _null_memory_resource: public memory_resource {
+        protected:
+            void* do_allocate(size_t, size_t) { throw std::bad_alloc(); }
+            void do_deallocate(void*, size_t, size_t) {}
+        };
+
+        inline memory_resource* new_delete_resource() {
+            static _new_delete_resource resource;
+            return &resource;
+        }
+
+        inline memory_resource* null_memory_resource() {
+            static _null_memory_resource resource;
+            return &resource;
+        }
+
+        inline memory_resource*& _default_resource() {
+            static memory_resource* resource = new_delete_resource();
+            return resource;
+        }
+
+        inline memory_resource* get_default_resource() {
+            return __atomic_load_n(&_default_resource(), __ATOMIC_ACQUIRE);
+        }
+
+        // Returns the previous default; NULL restores new_delete_resource().
+        inline memory_resource* set_default_resource(memory_resource* r) {
+            if (r == NULL)
+                r = new_delete_resource();
+            return __atomic_exchange_n(&_default_resource(), r, __ATOMIC_ACQ_REL);
+        }
+
+        inline size_t _align_up(size_t n, size_t alignment) {
+            return (n + alignment - 1) & ~(alignment - 1);
+        }
+
+        // Bump allocator: hands out consecutive pieces of a buffer, takes a
+        // twice larger chunk from upstream when it runs out, and ignores
+        // deallocate. Everything is given back at once by release() or the
+        // destructor, which suits per-request arenas. Not thread-safe.
+        class monotonic_buffer_resource: public memory_resource {
+        public:
+            explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource()):
+                _upstream(upstream), _chunks(NULL), _initial(NULL), _initial_size(0), _next_size(_min_chunk) {
+                _reset();
+            }
+
+            explicit monotonic_buffer_resource(size_t initial_size, memory_resource* upstream = get_default_resource()):
+                _upstream(upstream), _chunks(NULL), _initial(NULL), _initial_size(0),
+                _next_size(initial_size < _min_chunk ? _min_chunk : initial_size) {
+                _reset();
+            }
+
+            // Serves from buffer first; the caller keeps ownership of it.
+            monotonic_buffer_resource(void* buffer, size_t size, memory_resource* upstream = get_default_resource()):
+                _upstream(upstream), _chunks(NULL), _initial(static_cast<char*>(buffer)), _initial_size(size),
+                _next_size(size < _min_chunk ? _min_chunk : size * 2) {
+                _reset();
+            }
+
+            ~monotonic_buffer_resource() { release(); }
+
+            // Returns every chunk to upstream and starts over from the
+            // initial buffer.
+            void release() {
+                while (_chunks != NULL) {
+                    _chunk* next = _chunks->next;
+                    _upstream->deallocate(_chunks, _chunks->size, max_align);
+                    _chunks = next;
+                }
+                _reset();
+            }
+
+            memory_resource* upstream_resource() const { return _upstream; }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) {
+                if (bytes == 0)
+                    bytes = 1;
+                size_t offset = _align_up(reinterpret_cast<size_t>(_current), alignment) - reinterpret_cast<size_t>(_current);
+                if (_current == NULL || offset > _left || bytes > _left - offset) {
+                    _grow(bytes + alignment);
+                    offset = _align_up(reinterpret_cast<size_t>(_current), alignment) - reinterpret_cast<size_t>(_current);
+                }
+                char* p = _current + offset;
+                _current = p + bytes;
+                _left -= offset + bytes;
+                return p;
+            }
+
+            void do_deallocate(void*, size_t, size_t) {}
+
+        private:
+            struct _chunk {
+                _chunk* next;
+                size_t size;
+            };
+
+            static const size_t _min_chunk = 1024;
+
+            memory_resource* _upstream;
+            _chunk* _chunks;
+            char* _initial;
+            size_t _initial_size;
+            size_t _next_size;
+            char* _current;
+            size_t _left;
+
+            monotonic_buffer_resource(const monotonic_buffer_resource&);
+            monotonic_buffer_resource& operator=(const monotonic_buffer_resource&);
+
+            void _reset() {
+                _current = _initial;
+                _left = _initial_size;
+            }
+
+            void _grow(size_t wanted) {
+                size_t header = _align_up(sizeof(_chunk), max_align);
+                size_t size = _next_size;
+                if (size < wanted + header)
+                    size = wanted + header;
+                _chunk* c = static_cast<_chunk*>(_upstream->allocate(size, max_align));
+                c->next = _chunks;
+                c->size = size;
+                _chunks = c;
+                _current = reinterpret_cast<char*>(c) + header;
+                _left = size - header;
+                if (_next_size <= std::numeric_limits<size_t>::max() / 2)
+                    _next_size *= 2;
+            }
+        };
+
+        struct pool_options {
+            // Most blocks a pool takes from upstream at once; 0 for the
+            // default.
+            size_t max_blocks_per_chunk;
+            // Larger requests bypass the pools and go straight upstream; 0
+            // for the default.
+            size_t largest_required_pool_block;
+
+            pool_options(): max_blocks_per_chunk(0), largest_required_pool_block(0) {}
+        };
+
+        // Free lists of fixed-size blocks, one per power of two from 8 bytes
+        // up to largest_required_pool_block. Each pool carves its blocks out
+        // of chunks from upstream that double in size, so node-based
+        // containers like ft::map reuse freed nodes without going back to
+        // the general-purpose allocator. Oversized requests are passed
+        // upstream and tracked so release() can free them too. Not
+        // thread-safe.
+        class pool_resource: public memory_resource {
+        public:
+            explicit pool_resource(memory_resource* upstream = get_default_resource()): _upstream(upstream), _big(NULL) {
+                _init(pool_options());
+            }
+
+            explicit pool_resource(const pool_options& opts, memory_resource* upstream = get_default_resource()):
+                _upstream(upstream), _big(NULL) {
+                _init(opts);
+            }
+
+            ~pool_resource() { release(); }
+
+            // Frees every chunk and oversized block, whether or not its
+            // blocks were deallocated.
+            void release() {
+                for (size_t i = 0; i < _pool_count; ++i) {
+                    _pool& pool = _pools[i];
+                    while (pool.chunks != NULL) {
+                        _chunk* next = pool.chunks->next;
+                        _upstream->deallocate(pool.chunks, pool.chunks->size, max_align);
+                        pool.chunks = next;
+                    }
+                    pool.free = NULL;
+                    pool.next_blocks = _first_blocks;
+                }
+                while (_big != NULL) {
+                    _big_block* next = _big->next;
+                    _upstream->deallocate(_big->base, _big->size, _big->alignment);
+                    _big = next;
+                }
+            }
+
+            pool_options options() const { return _options; }
+            memory_resource* upstream_resource() const { return _upstream; }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) {
+                size_t index = _pool_index(bytes, alignment);
+                if (index == _pool_count)
+                    return _allocate_big(bytes, alignment);
+                _pool& pool = _pools[index];
+                if (pool.free == NULL)
+                    _refill(pool, index);
+                _free_block* block = pool.free;
+                pool.free = block->next;
+                return block;
+            }
+
+            void do_deallocate(void* p, size_t bytes, size_t alignment) {
+                size_t index = _pool_index(bytes, alignment);
+                if (index == _pool_count) {
+                    _deallocate_big(p);
+                    return ;
+                }
+                _free_block* block = static_cast<_free_block*>(p);
+                block->next = _pools[index].free;
+                _pools[index].free = block;
+            }
+
+        private:
+            struct _free_block {
+                _free_block* next;
+            };
+
+            struct _chunk {
+                _chunk* next;
+                size_t size;
+            };
+
+            struct _pool {
+                _free_block* free;
+                _chunk* chunks;
+                size_t next_blocks;
+            };
+
+            // Sits right before each oversized block, in a doubly linked list.
+            struct _big_block {
+                _big_block* prev;
+                _big_block* next;
+                void* base;
+                size_t size;
+                size_t alignment;
+            };
+
+            static const size_t _min_block_log = 3;
+            static const size_t _max_pools = 24;
+            static const size_t _first_blocks = 16;
+            static const size_t _default_max_blocks = 1024;
+            static const size_t _default_largest_block = 4096;
+
+            memory_resource* _upstream;
+            pool_options _options;
+            _pool _pools[_max_pools];
+            size_t _pool_count;
+            _big_block* _big;
+
+            pool_resource(const pool_resource&);
+            pool_resource& operator=(const pool_resource&);
+
+            void _init(const pool_options& opts) {
+                _options = opts;
+                if (_options.max_blocks_per_chunk == 0)
+                    _options.max_blocks_per_chunk = _default_max_blocks;
+                if (_options.largest_required_pool_block == 0)
+                    _options.largest_required_pool_block = _default_largest_block;
+                _pool_count = 0;
+                while (_pool_count < _max_pools && (size_t(1) << (_pool_count + _min_block_log)) < _options.largest_required_pool_block)
+                    ++_pool_count;
+                if (_pool_count < _max_pools)
+                    ++_pool_count;
+                _options.largest_required_pool_block = _block_size(_pool_count - 1);
+                for (size_t i = 0; i < _max_pools; ++i) {
+                    _pools[i].free = NULL;
+                    _pools[i].chunks = NULL;
+                    _pools[i].next_blocks = _first_blocks;
+                }
+            }
+
+            static size_t _block_size(size_t index) { return size_t(1) << (index + _min_block_log); }
+
+            // Blocks of a pool are aligned to their size, up to max_align.
+            size_t _pool_index(size_t bytes, size_t alignment) const {
+                if (alignment > max_align || bytes > _options.largest_required_pool_block)
+                    return _pool_count;
+                if (bytes < alignment)
+                    bytes = alignment;
+                size_t index = 0;
+                while (_block_size(index) < bytes)
+                    ++index;
+                return index;
+            }
+
+            void _refill(_pool& pool, size_t index) {
+                size_t block = _block_size(index);
+                size_t header = _align_up(sizeof(_chunk), max_align);
+                size_t count = pool.next_blocks;
+                size_t size = header + count * block;
+                _chunk* c = static_cast<_chunk*>(_upstream->allocate(size, max_align));
+                c->next = pool.chunks;
+                c->size = size;
+                pool.chunks = c;
+                char* first = reinterpret_cast<char*>(c) + header;
+                for (size_t i = count; i-- > 0; ) {
+                    _free_block* b = reinterpret_cast<_free_block*>(first + i * block);
+                    b->next = pool.free;
+                    pool.free = b;
+                }
+                if (pool.next_blocks < _options.max_blocks_per_chunk)
+                    pool.next_blocks = pool.next_blocks * 2 < _options.max_blocks_per_chunk
+                            ? pool.next_blocks * 2 : _options.max_blocks_per_chunk;
+            }
+
+            void* _allocate_big(size_t bytes, size_t alignment) {
+                if (alignment < max_align)
+                    alignment = max_align;
+                size_t header = _align_up(sizeof(_big_block), alignment);
+                size_t size = header + bytes;
+                char* base = static_cast<char*>(_upstream->allocate(size, alignment));
+                _big_block* b = reinterpret_cast<_big_block*>(base + header) - 1;
+                b->prev = NULL;
+                b->next = _big;
+                b->base = base;
+                b->size = size;
+                b->alignment = alignment;
+                if (_big != NULL)
+                    _big->prev = b;
+                _big = b;
+                return base + header;
+            }
+
+            void _deallocate_big(void* p) {
+                _big_block* b = static_cast<_big_block*>(p) - 1;
+                if (b->prev != NULL)
+                    b->prev->next = b->next;
+                else
+                    _big = b->next;
+                if (b->next != NULL)
+                    b->next->prev = b->prev;
+                _upstream->deallocate(b->base, b->size, b->alignment);
+            }
+        };
+
+        // Standard allocator interface over a memory_resource, so one
+        // container type can draw from any arena. Copies and rebinds share
+        // the resource; the default is get_default_resource().
+        template<class T>
+        class polymorphic_allocator: public basic_allocator<T> {
+        public:
+            typedef typename basic_allocator<T>::pointer pointer;
+            typedef typename basic_allocator<T>::size_type size_type;
+
+            template<class U>
+            struct rebind { typedef polymorphic_allocator<U> other; };
+
+            polymorphic_allocator(): _resource(get_default_resource()) {}
+            polymorphic_allocator(memory_resource* r): _resource(r) {}
+            polymorphic_allocator(const polymorphic_allocator& other): basic_allocator<T>(), _resource(other._resource) {}
+            template<class U>
+            polymorphic_allocator(const polymorphic_allocator<U>& other): _resource(other.resource()) {}
+            ~polymorphic_allocator() {}
+
+            polymorphic_allocator& operator=(const polymorphic_allocator& other) {
+                _resource = other._resource;
+                return *this;
+            }
+
+            pointer allocate(size_type n, const void* = 0) {
+                if (n == 0)
+                    return NULL;
+                if (n > this->max_size())
+                    throw std::bad_alloc();
+                return static_cast<pointer>(_resource->allocate(n * sizeof(T), __alignof__(T)));
+            }
+
+            // Containers may hand back the null pointer of an empty buffer;
+            // the resources never see it.
+            void deallocate(pointer p, size_type n) {
+                if (p == NULL)
+                    return ;
+                _resource->deallocate(p, n * sizeof(T), __alignof__(T));
+            }
+
+            memory_resource* resource() const { return _resource; }
+
+        private:
+            memory_resource* _resource;
+        };
+
+        template<class T, class U>
+        bool operator==(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) {
+            return *lhs.resource() == *rhs.resource();
+        }
+
+        template<class T, class U>
+        bool operator!=(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) { return !(lhs == rhs); }
+    }
+}
+
+#endif//FT_CONTAINERS_MEMORY_RESOURCE_HPP
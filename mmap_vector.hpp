@@ -0,0 +1,398 @@
+#ifndef FT_CONTAINERS_MMAP_VECTOR_HPP
+# define FT_CONTAINERS_MMAP_VECTOR_HPP
+# include <cstddef>
+# include <cstring>
+# include <cerrno>
+# include <string>
+# include <stdexcept>
+# include <limits>
+# include <algorithm>
+# include <iterator>
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include "algorithm.hpp"
+# include "vector_iterator.hpp"
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+namespace ft {
+// ft::vector interface over a file mapped with mmap. The file holds the
+// elements as raw bytes; it is grown ahead of the size with ftruncate and
+// remapped, and cut back to exactly size() elements when closed, so files
+// that are not a whole number of elements are refused at open.
+// Only for trivially copyable T, and the bytes are not portable across
+// architectures.
+template< class T >
+class mmap_vector {
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef reverse_vector_iterator<iterator> reverse_iterator;
+    typedef reverse_vector_iterator<const_iterator> const_reverse_iterator;
+
+    // A read_only vector must be read through a const reference: the
+    // modifiers and the non-const accessors and iterators all throw for it,
+    // since a write through them would fault on the read-only mapping. A
+    // range-for over a non-const read_only vector throws too.
+    enum open_mode {
+        read_write,     // open or create, keep the contents
+        truncate,       // open or create, start empty
+        read_only       // shared read-only mapping
+    };
+
+    enum access_advice {
+        normal,
+        sequential,
+        random,
+        willneed,
+        dontneed
+    };
+
+    explicit mmap_vector( const std::string& path, open_mode mode = read_write ):
+        _size(0), _capacity(0), _array(NULL), _fd(-1), _mode(mode), _path(path) {
+        typedef char requires_trivially_copyable_type[is_trivially_copyable<T>::value ? 1 : -1];
+        (void)sizeof(requires_trivially_copyable_type);
+        int flags = mode == read_only ? O_RDONLY : O_RDWR | O_CREAT;
+        if (mode == truncate)
+            flags |= O_TRUNC;
+        _fd = ::open(path.c_str(), flags, 0644);
+        if (_fd < 0)
+            _fail("open");
+        struct stat st;
+        if (fstat(_fd, &st) != 0) {
+            int error = errno;
+            ::close(_fd);
+            errno = error;
+            _fail("fstat");
+        }
+        if (static_cast<size_type>(st.st_size) % sizeof(T) != 0) {
+            ::close(_fd);
+            throw std::runtime_error("mmap_vector: " + path + " is not a whole number of elements");
+        }
+        _size = static_cast<size_type>(st.st_size) / sizeof(T);
+        try {
+            _map(_size);
+        }
+        catch (...) {
+            ::close(_fd);
+            throw;
+        }
+    }
+
+    ~mmap_vector() {
+        _close();
+    }
+
+    size_type size() const { return _size; }
+    size_type capacity() const { return _capacity; }
+    bool empty() const { return _size == 0; }
+    bool is_read_only() const { return _mode == read_only; }
+    const std::string& path() const { return _path; }
+    size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(value_type); }
+
+    T& operator[]( size_type pos ) {
+        _writable();
+        return _array[pos];
+    }
+    const T& operator[]( size_type pos ) const { return _array[pos]; }
+
+    T& at( size_type pos ) {
+        _writable();
+        if (pos >= _size)
+            throw std::out_of_range("Index out of range");
+        return _array[pos];
+    }
+    const T& at( size_type pos ) const {
+        if (pos >= _size)
+            throw std::out_of_range("Index out of range");
+        return _array[pos];
+    }
+
+    T& front() { return *begin(); }
+    const T& front() const { return _array[0]; }
+    T& back() { return *(end() - 1); }
+    const T& back() const { return _array[_size - 1]; }
+    T* data() { return begin(); }
+    const T* data() const { return _array; }
+
+    iterator begin() {
+        _writable();
+        return iterator(_array);
+    }
+    const_iterator begin() const { return const_iterator(_array); }
+    iterator end() {
+        _writable();
+        return iterator(_array + _size);
+    }
+    const_iterator end() const { return const_iterator(_array + _size); }
+    reverse_iterator rbegin() { return reverse_iterator(end() - 1); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end() - 1); }
+    reverse_iterator rend() { return reverse_iterator(begin() - 1); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin() - 1); }
+
+    void reserve( size_type new_cap ) {
+        if (new_cap <= _capacity)
+            return ;
+        _writable();
+        _remap(new_cap);
+    }
+
+    // Cuts the file back to the elements in use.
+    void shrink_to_fit() {
+        if (_capacity == _size)
+            return ;
+        _writable();
+        _remap(_size);
+    }
+
+    void resize( size_type count, T value = T() ) {
+        _writable();
+        if (count > _capacity)
+            reserve(count);
+        if (count > _size)
+            std::fill(_array + _size, _array + count, value);
+        _size = count;
+    }
+
+    void clear() {
+        _writable();
+        _size = 0;
+    }
+
+    void assign( size_type count, const T& value ) {
+        clear();
+        resize(count, value);
+    }
+
+    template< class InputIt >
+    typename enable_if<!is_integral<InputIt>::value, void >::type assign( InputIt first, InputIt last ) {
+        clear();
+        insert(end(), first, last);
+    }
+
+    void push_back( const T& value ) {
+        _writable();
+        if (_size == _capacity) {
+            T tmp(value);
+            reserve(_next_capacity(_size + 1));
+            _array[_size++] = tmp;
+            return ;
+        }
+        _array[_size++] = value;
+    }
+
+    void pop_back() {
+        _writable();
+        --_size;
+    }
+
+    iterator insert( iterator pos, const T& value ) {
+        size_type index = pos - begin();
+        insert(pos, 1, value);
+        return _array + index;
+    }
+
+    void insert( iterator pos, size_type count, const T& value ) {
+        _writable();
+        if (count == 0)
+            return ;
+        size_type index = pos - begin();
+        T tmp(value);
+        _open_gap(index, count);
+        std::fill(_array + index, _array + index + count, tmp);
+    }
+
+    template< class InputIt >
+    typename enable_if<!is_integral<InputIt>::value, void >::type insert( iterator pos, InputIt first, InputIt last ) {
+        _writable();
+        size_type index = pos - begin();
+        size_type count = std::distance(first, last);
+        if (count == 0)
+            return ;
+        _open_gap(index, count);
+        std::copy(first, last, _array + index);
+    }
+
+    iterator erase( iterator pos ) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase( iterator first, iterator last ) {
+        _writable();
+        if (first >= last)
+            return last;
+        std::memmove(static_cast<void*>(first), static_cast<const void*>(last), (end() - last) * sizeof(T));
+        _size -= last - first;
+        return first;
+    }
+
+    // Tells the kernel how the elements [first, first + count) will be read.
+    void advise( access_advice advice, size_type first = 0, size_type count = static_cast<size_type>(-1) ) {
+        if (_array == NULL || first >= _capacity)
+            return ;
+        if (count > _capacity - first)
+            count = _capacity - first;
+        size_t page = page_size();
+        char* begin = reinterpret_cast<char*>(_array + first);
+        char* aligned = reinterpret_cast<char*>(_array) + (begin - reinterpret_cast<char*>(_array)) / page * page;
+        size_t length = begin + count * sizeof(T) - aligned;
+        if (madvise(aligned, length, _advice(advice)) != 0)
+            _fail("madvise");
+    }
+
+    // Flushes dirty pages of the mapping to the file.
+    void sync( bool wait = true ) {
+        if (_array != NULL && _mode != read_only && msync(_array, _bytes(_capacity), wait ? MS_SYNC : MS_ASYNC) != 0)
+            _fail("msync");
+    }
+
+    void swap( mmap_vector& other ) {
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+        std::swap(_array, other._array);
+        std::swap(_fd, other._fd);
+        std::swap(_mode, other._mode);
+        _path.swap(other._path);
+    }
+
+private:
+    size_t _size;
+    size_t _capacity;
+    T* _array;
+    int _fd;
+    open_mode _mode;
+    std::string _path;
+
+    mmap_vector( const mmap_vector& );
+    mmap_vector& operator=( const mmap_vector& );
+
+    static size_t _bytes( size_type n ) { return n * sizeof(T); }
+
+    void _fail( const char* what ) const {
+        throw std::runtime_error(std::string("mmap_vector: ") + what + " " + _path + ": " + std::strerror(errno));
+    }
+
+    void _writable() const {
+        if (_mode == read_only)
+            throw std::runtime_error("mmap_vector: " + _path + " is mapped read-only");
+    }
+
+    // Doubles, but in whole pages, so the file is extended a page at a time
+    // at least.
+    size_type _next_capacity( size_type required ) const {
+        size_type grown = _capacity == 0 ? 1 : 2 * _capacity;
+        if (grown < required)
+            grown = required;
+        return round_to_pages(_bytes(grown)) / sizeof(T);
+    }
+
+    void _map( size_type cap ) {
+        _capacity = cap;
+        if (cap == 0) {
+            _array = NULL;
+            return ;
+        }
+        int prot = _mode == read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* p = mmap(NULL, _bytes(cap), prot, MAP_SHARED, _fd, 0);
+        if (p == MAP_FAILED)
+            _fail("mmap");
+        _array = static_cast<T*>(p);
+    }
+
+    // Resizes the file to new_cap elements and the mapping with it; mremap
+    // keeps the pages in place where the kernel can.
+    void _remap( size_type new_cap ) {
+        if (ftruncate(_fd, _bytes(new_cap)) != 0)
+            _fail("ftruncate");
+        if (_array == NULL || new_cap == 0) {
+            if (_array != NULL)
+                munmap(_array, _bytes(_capacity));
+            _map(new_cap);
+            return ;
+        }
+# ifdef MREMAP_MAYMOVE
+        void* p = mremap(_array, _bytes(_capacity), _bytes(new_cap), MREMAP_MAYMOVE);
+        if (p == MAP_FAILED)
+            _fail("mremap");
+        _array = static_cast<T*>(p);
+        _capacity = new_cap;
+# else
+        munmap(_array, _bytes(_capacity));
+        _map(new_cap);
+# endif
+    }
+
+    void _open_gap( size_type index, size_type count ) {
+        if (_size + count > _capacity)
+            reserve(_next_capacity(_size + count));
+        std::memmove(static_cast<void*>(_array + index + count), static_cast<const void*>(_array + index),
+                     (_size - index) * sizeof(T));
+        _size += count;
+    }
+
+    static int _advice( access_advice advice ) {
+        switch (advice) {
+            case sequential: return MADV_SEQUENTIAL;
+            case random: return MADV_RANDOM;
+            case willneed: return MADV_WILLNEED;
+            case dontneed: return MADV_DONTNEED;
+            default: return MADV_NORMAL;
+        }
+    }
+
+    void _close() {
+        if (_array != NULL)
+            munmap(_array, _bytes(_capacity));
+        if (_fd >= 0) {
+            if (_mode != read_only && _capacity != _size)
+                (void)ftruncate(_fd, _bytes(_size));
+            ::close(_fd);
+        }
+        _array = NULL;
+        _fd = -1;
+    }
+};
+
+template< class T >
+bool operator==( const ft::mmap_vector<T>& lhs,
+                const ft::mmap_vector<T>& rhs ) {
+    return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template< class T >
+bool operator!=( const ft::mmap_vector<T>& lhs,
+                const ft::mmap_vector<T>& rhs ) { return !(lhs == rhs); }
+
+template< class T >
+bool operator<( const ft::mmap_vector<T>& lhs,
+               const ft::mmap_vector<T>& rhs ) {
+    return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template< class T >
+bool operator>( const ft::mmap_vector<T>& lhs,
+               const ft::mmap_vector<T>& rhs ) { return rhs < lhs; }
+
+template< class T >
+bool operator<=( const ft::mmap_vector<T>& lhs,
+                const ft::mmap_vector<T>& rhs ) { return !(rhs < lhs); }
+
+template< class T >
+bool operator>=( const ft::mmap_vector<T>& lhs,
+                const ft::mmap_vector<T>& rhs ) { return !(lhs < rhs); }
+
+template< class T >
+void swap( ft::mmap_vector<T>& lhs,
+          ft::mmap_vector<T>& rhs ) { lhs.swap(rhs); }
+}
+
+#endif//FT_CONTAINERS_MMAP_VECTOR_HPP
@@ -0,0 +1,172 @@
+#ifndef FT_CONTAINERS_MPMC_QUEUE_HPP
+# define FT_CONTAINERS_MPMC_QUEUE_HPP
+# include <memory>
+# include <cstddef>
+# include <stdexcept>
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+namespace ft {
+    // Bounded queue for any number of producer and consumer threads, after
+    // Dmitry Vyukov's design. Each cell carries a sequence number telling
+    // whether it is ready for the producer or the consumer of a given lap of
+    // the ring, so a push or pop is one CAS on its index plus one store to the
+    // cell, and threads only contend on the index they share.
+    //
+    // Constructing T must not throw: a push that fails after claiming its
+    // cell would stall the consumer waiting for it.
+    template< class T, class Alloc = std::allocator<T> >
+    class mpmc_queue {
+    public:
+        typedef T value_type;
+        typedef Alloc allocator_type;
+        typedef size_t size_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+
+        // The capacity is rounded up to a power of two.
+        explicit mpmc_queue( size_type capacity, const allocator_type& alloc = allocator_type() ):
+            _cells(NULL), _mask(0), _enqueue(0), _dequeue(0), _allocator(alloc) {
+            if (capacity == 0)
+                throw std::invalid_argument("mpmc_queue: capacity must not be zero");
+            size_type size = 1;
+            while (size < capacity)
+                size <<= 1;
+            _cells = _allocator.allocate(size);
+            _mask = size - 1;
+            for (size_type i = 0; i < size; ++i)
+                _cells[i].sequence = i;
+        }
+
+        ~mpmc_queue() {
+            while (_dequeue != _enqueue) {
+                _cell* cell = &_cells[_dequeue & _mask];
+                cell->value()->~T();
+                ++_dequeue;
+            }
+            _allocator.deallocate(_cells, _mask + 1);
+        }
+
+        size_type capacity() const { return _mask + 1; }
+
+        // Only a snapshot while other threads push or pop.
+        size_type size() const {
+            size_type head = __atomic_load_n(&_dequeue, __ATOMIC_RELAXED);
+            size_type tail = __atomic_load_n(&_enqueue, __ATOMIC_RELAXED);
+            return tail > head ? tail - head : 0;
+        }
+        bool empty() const { return size() == 0; }
+
+        bool try_push( const T& value ) {
+            _cell* cell = _claim_push();
+            if (cell == NULL)
+                return false;
+            ::new (static_cast<void*>(cell->value())) T(value);
+            cell->publish();
+            return true;
+        }
+
+# if FT_CONTAINERS_CXX11
+        bool try_push( T&& value ) {
+            return try_emplace(std::move(value));
+        }
+
+        template< class... Args >
+        bool try_emplace( Args&&... args ) {
+            _cell* cell = _claim_push();
+            if (cell == NULL)
+                return false;
+            ::new (static_cast<void*>(cell->value())) T(std::forward<Args>(args)...);
+            cell->publish();
+            return true;
+        }
+# endif
+
+        bool try_pop( T& out ) {
+            size_type pos = __atomic_load_n(&_dequeue, __ATOMIC_RELAXED);
+            _cell* cell;
+            for (;;) {
+                cell = &_cells[pos & _mask];
+                size_type seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                difference_type diff = static_cast<difference_type>(seq - (pos + 1));
+                if (diff == 0) {
+                    if (__atomic_compare_exchange_n(&_dequeue, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = __atomic_load_n(&_dequeue, __ATOMIC_RELAXED);
+            }
+            T* value = cell->value();
+            out = FT_MOVE(*value);
+            value->~T();
+            __atomic_store_n(&cell->sequence, pos + _mask + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        // Blocking versions: spin, then yield, until there is room or an
+        // element.
+        void push( const T& value ) {
+            spin_backoff backoff;
+            while (!try_push(value))
+                backoff.pause();
+        }
+
+        void pop( T& out ) {
+            spin_backoff backoff;
+            while (!try_pop(out))
+                backoff.pause();
+        }
+
+    private:
+        typedef ptrdiff_t difference_type;
+
+        struct _cell {
+            size_type sequence;
+            char storage[sizeof(T)] __attribute__((aligned(__alignof__(T))));
+
+            T* value() { return reinterpret_cast<T*>(storage); }
+            void publish() {
+                __atomic_store_n(&sequence, __atomic_load_n(&sequence, __ATOMIC_RELAXED) + 1, __ATOMIC_RELEASE);
+            }
+        };
+        typedef typename Alloc::template rebind<_cell>::other cell_allocator_type;
+
+        // The indices each get a cache line of their own, away from the
+        // read-only ring pointer, so producers and consumers do not
+        // invalidate each other's lines.
+        _cell* _cells;
+        size_type _mask;
+        char _pad0[cache_line_size - sizeof(_cell*) - sizeof(size_type)];
+        size_type _enqueue;
+        char _pad1[cache_line_size - sizeof(size_type)];
+        size_type _dequeue;
+        char _pad2[cache_line_size - sizeof(size_type)];
+        cell_allocator_type _allocator;
+
+        mpmc_queue( const mpmc_queue& );
+        mpmc_queue& operator=( const mpmc_queue& );
+
+        // Reserves the cell at the enqueue index, or returns NULL when the
+        // ring is full.
+        _cell* _claim_push() {
+            size_type pos = __atomic_load_n(&_enqueue, __ATOMIC_RELAXED);
+            for (;;) {
+                _cell* cell = &_cells[pos & _mask];
+                size_type seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                difference_type diff = static_cast<difference_type>(seq - pos);
+                if (diff == 0) {
+                    if (__atomic_compare_exchange_n(&_enqueue, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                        return cell;
+                }
+                else if (diff < 0)
+                    return NULL;
+                else
+                    pos = __atomic_load_n(&_enqueue, __ATOMIC_RELAXED);
+            }
+        }
+    };
+}
+
+#endif//FT_CONTAINERS_MPMC_QUEUE_HPP
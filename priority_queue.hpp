@@ -0,0 +1,349 @@
+#ifndef FT_CONTAINERS_PRIORITY_QUEUE_HPP
+# define FT_CONTAINERS_PRIORITY_QUEUE_HPP
+# include <cstddef>
+# include <functional>
+# include <stdexcept>
+# include "vector.hpp"
+
+namespace ft {
+    // Heap layout shared by the adaptors below: 4 children per node keeps the
+    // tree half as deep as a binary heap and the siblings on one cache line.
+    template<class Container, class Compare>
+    class d_ary_heap {
+    public:
+        typedef typename Container::size_type size_type;
+        typedef typename Container::value_type value_type;
+        static const size_type arity = 4;
+
+        static size_type parent(size_type i) { return (i - 1) / arity; }
+        static size_type firstChild(size_type i) { return i * arity + 1; }
+
+        static void siftUp(Container & c, size_type i, const Compare & comp) {
+            value_type tmp = c[i];
+            while (i > 0) {
+                size_type p = parent(i);
+                if (!comp(c[p], tmp))
+                    break;
+                c[i] = c[p];
+                i = p;
+            }
+            c[i] = tmp;
+        }
+
+        static void siftDown(Container & c, size_type i, const Compare & comp) {
+            size_type n = c.size();
+            value_type tmp = c[i];
+            for (;;) {
+                size_type child = firstChild(i);
+                if (child >= n)
+                    break;
+                size_type last = child + arity < n ? child + arity : n;
+                size_type best = child;
+                for (++child; child < last; ++child)
+                    if (comp(c[best], c[child]))
+                        best = child;
+                if (!comp(tmp, c[best]))
+                    break;
+                c[i] = c[best];
+                i = best;
+            }
+            c[i] = tmp;
+        }
+
+        static void makeHeap(Container & c, const Compare & comp) {
+            size_type n = c.size();
+            if (n < 2)
+                return ;
+            for (size_type i = parent(n - 1) + 1; i-- > 0; )
+                siftDown(c, i, comp);
+        }
+    };
+
+    template<
+            class T,
+            class Container = ft::vector<T>,
+            class Compare = std::less<typename Container::value_type> >
+    class priority_queue {
+    public:
+        typedef Container container_type;
+        typedef Compare value_compare;
+        typedef typename Container::value_type value_type;
+        typedef typename Container::size_type size_type;
+        typedef typename Container::reference reference;
+        typedef typename Container::const_reference const_reference;
+
+        explicit priority_queue( const Compare& compare = Compare(),
+                                const Container& cont = Container() ): c(cont), comp(compare) {
+            heap::makeHeap(c, comp);
+        }
+
+        template< class InputIt >
+        priority_queue( InputIt first, InputIt last,
+                       const Compare& compare = Compare(),
+                       const Container& cont = Container() ): c(cont), comp(compare) {
+            heap::makeHeap(c, comp);
+            push_range(first, last);
+        }
+
+        priority_queue( const priority_queue& other ): c(other.c), comp(other.comp) {}
+        ~priority_queue() {}
+
+        priority_queue& operator=( const priority_queue& other ) {
+            if (this != &other) {
+                c = other.c;
+                comp = other.comp;
+            }
+            return *this;
+        }
+
+        const_reference top() const { return c.front(); }
+        bool empty() const { return c.empty(); }
+        size_type size() const { return c.size(); }
+        memory_footprint memory_usage() const { return c.memory_usage(); }
+
+        void push( const value_type& value ) {
+            c.push_back(value);
+            heap::siftUp(c, c.size() - 1, comp);
+        }
+
+        // Appends the whole range, then either sifts the new tail up or
+        // rebuilds the heap bottom-up in O(n), whichever touches less.
+        template< class InputIt >
+        void push_range( InputIt first, InputIt last ) {
+            size_type old_size = c.size();
+            for ( ; first != last ; ++first)
+                c.push_back(*first);
+            size_type added = c.size() - old_size;
+            if (added == 0)
+                return ;
+            size_type depth = 1;
+            for (size_type n = c.size(); n >= heap::arity; n /= heap::arity)
+                ++depth;
+            if (added * depth >= c.size())
+                heap::makeHeap(c, comp);
+            else
+                for (size_type i = old_size; i < c.size(); ++i)
+                    heap::siftUp(c, i, comp);
+        }
+
+        void pop() {
+            if (c.size() > 1) {
+                c.front() = c.back();
+                c.pop_back();
+                heap::siftDown(c, 0, comp);
+            }
+            else
+                c.pop_back();
+        }
+
+        void swap( priority_queue& other ) {
+            c.swap(other.c);
+            std::swap(comp, other.comp);
+        }
+
+    protected:
+        Container c;
+        Compare comp;
+
+    private:
+        typedef d_ary_heap<Container, Compare> heap;
+    };
+
+    template< class T, class Container, class Compare >
+    void swap( ft::priority_queue<T,Container,Compare>& lhs,
+              ft::priority_queue<T,Container,Compare>& rhs ) {
+        lhs.swap(rhs);
+    }
+
+    // Heap whose elements are reachable through stable handles, so a queued
+    // value can be re-prioritised or removed in O(log n).
+    template< class T, class Compare = std::less<T> >
+    class addressable_priority_queue {
+    public:
+        typedef T value_type;
+        typedef Compare value_compare;
+        typedef size_t size_type;
+        typedef size_t handle_type;
+        typedef const T& const_reference;
+
+        static const handle_type npos = static_cast<handle_type>(-1);
+
+        explicit addressable_priority_queue( const Compare& compare = Compare() ): _comp(compare) {}
+        addressable_priority_queue( const addressable_priority_queue& other ):
+            _heap(other._heap), _pos(other._pos), _free(other._free), _comp(other._comp) {}
+        ~addressable_priority_queue() {}
+
+        addressable_priority_queue& operator=( const addressable_priority_queue& other ) {
+            if (this != &other) {
+                _heap = other._heap;
+                _pos = other._pos;
+                _free = other._free;
+                _comp = other._comp;
+            }
+            return *this;
+        }
+
+        const_reference top() const { return _heap.front().value; }
+        handle_type top_handle() const { return _heap.front().handle; }
+        bool empty() const { return _heap.empty(); }
+        size_type size() const { return _heap.size(); }
+
+        // The handle index and the free handle list count as node overhead.
+        memory_footprint memory_usage() const {
+            memory_footprint usage = _heap.memory_usage();
+            memory_footprint pos = _pos.memory_usage();
+            memory_footprint free = _free.memory_usage();
+            usage.node_overhead += pos.payload + free.payload;
+            usage.unused_capacity += pos.unused_capacity + free.unused_capacity;
+            return usage;
+        }
+
+        bool contains( handle_type h ) const {
+            return h < _pos.size() && _pos[h] != npos;
+        }
+
+        const_reference value( handle_type h ) const {
+            if (!contains(h))
+                throw std::out_of_range("Handle is not in the queue");
+            return _heap[_pos[h]].value;
+        }
+
+        handle_type push( const value_type& value ) {
+            handle_type h;
+            if (_free.empty()) {
+                h = _pos.size();
+                _pos.push_back(npos);
+            }
+            else {
+                h = _free.back();
+                _free.pop_back();
+            }
+            _heap.push_back(entry(value, h));
+            _pos[h] = _heap.size() - 1;
+            _siftUp(_heap.size() - 1);
+            return h;
+        }
+
+        void pop() {
+            _remove(0);
+        }
+
+        void erase( handle_type h ) {
+            if (!contains(h))
+                throw std::out_of_range("Handle is not in the queue");
+            _remove(_pos[h]);
+        }
+
+        // Named after the std::greater min-heap of Dijkstra and Prim, where
+        // a smaller value moves towards the top. Under the default std::less
+        // a decreased value moves down instead, so both check the direction
+        // like update() rather than trusting the name.
+        void decrease_key( handle_type h, const value_type& value ) { update(h, value); }
+        void increase_key( handle_type h, const value_type& value ) { update(h, value); }
+
+        // Moves the element up or down, whichever way value now orders.
+        void update( handle_type h, const value_type& value ) {
+            if (!contains(h))
+                throw std::out_of_range("Handle is not in the queue");
+            size_type i = _pos[h];
+            bool up = _comp(_heap[i].value, value);
+            _heap[i].value = value;
+            if (up)
+                _siftUp(i);
+            else
+                _siftDown(i);
+        }
+
+        void clear() {
+            _heap.clear();
+            _pos.clear();
+            _free.clear();
+        }
+
+        void swap( addressable_priority_queue& other ) {
+            _heap.swap(other._heap);
+            _pos.swap(other._pos);
+            _free.swap(other._free);
+            std::swap(_comp, other._comp);
+        }
+
+    private:
+        struct entry {
+            entry(): value(), handle(npos) {}
+            entry(const T& v, handle_type h): value(v), handle(h) {}
+            T value;
+            handle_type handle;
+        };
+        static const size_type arity = 4;
+
+        ft::vector<entry> _heap;
+        ft::vector<size_type> _pos;
+        ft::vector<handle_type> _free;
+        Compare _comp;
+
+        void _place( size_type i, const entry& e ) {
+            _heap[i] = e;
+            _pos[e.handle] = i;
+        }
+
+        void _siftUp( size_type i ) {
+            entry tmp = _heap[i];
+            while (i > 0) {
+                size_type p = (i - 1) / arity;
+                if (!_comp(_heap[p].value, tmp.value))
+                    break;
+                _place(i, _heap[p]);
+                i = p;
+            }
+            _place(i, tmp);
+        }
+
+        void _siftDown( size_type i ) {
+            size_type n = _heap.size();
+            entry tmp = _heap[i];
+            for (;;) {
+                size_type child = i * arity + 1;
+                if (child >= n)
+                    break;
+                size_type last = child + arity < n ? child + arity : n;
+                size_type best = child;
+                for (++child; child < last; ++child)
+                    if (_comp(_heap[best].value, _heap[child].value))
+                        best = child;
+                if (!_comp(tmp.value, _heap[best].value))
+                    break;
+                _place(i, _heap[best]);
+                i = best;
+            }
+            _place(i, tmp);
+        }
+
+        void _remove( size_type i ) {
+            handle_type h = _heap[i].handle;
+            _pos[h] = npos;
+            _free.push_back(h);
+            size_type last = _heap.size() - 1;
+            if (i != last) {
+                _place(i, _heap[last]);
+                _heap.pop_back();
+                if (i > 0 && _comp(_heap[(i - 1) / arity].value, _heap[i].value))
+                    _siftUp(i);
+                else
+                    _siftDown(i);
+            }
+            else
+                _heap.pop_back();
+        }
+    };
+
+    template< class T, class Compare >
+    const typename addressable_priority_queue<T,Compare>::handle_type addressable_priority_queue<T,Compare>::npos;
+
+    template< class T, class Compare >
+    void swap( ft::addressable_priority_queue<T,Compare>& lhs,
+              ft::addressable_priority_queue<T,Compare>& rhs ) {
+        lhs.swap(rhs);
+    }
+}
+
+#endif//FT_CONTAINERS_PRIORITY_QUEUE_HPP
@@ -0,0 +1,49 @@
+#ifndef FT_CONTAINERS_QUEUE_HPP
+# define FT_CONTAINERS_QUEUE_HPP
+# include <cstddef>
+# include "deque.hpp"
+
+namespace ft {
+template <class T, class Container = ft::deque<T> >
+class queue {
+public:
+    typedef T value_type;
+    typedef Container container_type;
+    typedef size_t size_type;
+
+    explicit queue( const container_type& ctnr = container_type() ): c(ctnr) {}
+    queue( const queue& other ): c(other.c) {}
+    ~queue() {}
+    queue& operator=( const queue& other ) {
+        if (this != &other)
+            c = other.c;
+        return *this;
+    }
+    value_type& front() { return c.front(); }
+    const value_type& front() const { return c.front(); }
+    value_type& back() { return c.back(); }
+    const value_type& back() const { return c.back(); }
+    size_type size() const { return c.size(); }
+    memory_footprint memory_usage() const { return c.memory_usage(); }
+    void push( const value_type& value ) { c.push_back(value); }
+    void pop() { c.pop_front(); }
+    bool empty() const { return c.empty(); }
+
+    friend bool operator== (const ft::queue<T,Container>& lhs, const ft::queue<T,Container>& rhs) { return lhs.c == rhs.c; }
+
+    friend bool operator!= (const ft::queue<T,Container>& lhs, const ft::queue<T,Container>& rhs) { return lhs.c != rhs.c; }
+
+    friend bool operator<  (const ft::queue<T,Container>& lhs, const ft::queue<T,Container>& rhs) { return lhs.c < rhs.c; }
+
+    friend bool operator<= (const ft::queue<T,Container>& lhs, const ft::queue<T,Container>& rhs) { return lhs.c <= rhs.c; }
+
+    friend bool operator>  (const ft::queue<T,Container>& lhs, const ft::queue<T,Container>& rhs) { return lhs.c > rhs.c; }
+
+    friend bool operator>= (const ft::queue<T,Container>& lhs, const ft::queue<T,Container>& rhs) { return lhs.c >= rhs.c; }
+
+protected:
+    container_type c;
+};
+}
+
+#endif // FT_CONTAINERS_QUEUE_HPP
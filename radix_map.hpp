@@ -0,0 +1,1118 @@
+#ifndef FT_CONTAINERS_RADIX_MAP_HPP
+# define FT_CONTAINERS_RADIX_MAP_HPP
+# include <memory>
+# include <cstddef>
+# include <cstring>
+# include <climits>
+# include <limits>
+# include <string>
+# include <functional>
+# include <stdexcept>
+# include <stdint.h>
+# if defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+# include "iterator.hpp"
+# include "vector_iterator.hpp"
+# include "utility.hpp"
+# include "algorithm.hpp"
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+namespace ft {
+    // How radix_map sees a key: size(key) bytes, byte(key, i) being the i-th
+    // most significant. Comparing those strings byte by byte must order keys
+    // as std::less<Key> does, since that is the order radix_map iterates in.
+    template<class Key>
+    struct radix_key_traits;
+
+    // Unsigned integers, as their big-endian bytes.
+    template<class Key>
+    struct radix_unsigned_key_traits {
+        static size_t size(const Key&) { return sizeof(Key); }
+        static unsigned char byte(const Key& key, size_t i) {
+            return static_cast<unsigned char>(key >> ((sizeof(Key) - 1 - i) * CHAR_BIT));
+        }
+    };
+
+    // Signed integers, with the sign bit flipped so negative keys come first.
+    template<class Key, class Unsigned>
+    struct radix_signed_key_traits {
+        static size_t size(const Key&) { return sizeof(Key); }
+        static unsigned char byte(const Key& key, size_t i) {
+            Unsigned bits = static_cast<Unsigned>(key) ^ (Unsigned(1) << (sizeof(Key) * CHAR_BIT - 1));
+            return static_cast<unsigned char>(bits >> ((sizeof(Key) - 1 - i) * CHAR_BIT));
+        }
+    };
+
+    template<> struct radix_key_traits<unsigned char>: radix_unsigned_key_traits<unsigned char> {};
+    template<> struct radix_key_traits<unsigned short>: radix_unsigned_key_traits<unsigned short> {};
+    template<> struct radix_key_traits<unsigned int>: radix_unsigned_key_traits<unsigned int> {};
+    template<> struct radix_key_traits<unsigned long>: radix_unsigned_key_traits<unsigned long> {};
+    template<> struct radix_key_traits<short>: radix_signed_key_traits<short, unsigned short> {};
+    template<> struct radix_key_traits<int>: radix_signed_key_traits<int, unsigned int> {};
+    template<> struct radix_key_traits<long>: radix_signed_key_traits<long, unsigned long> {};
+# if FT_CONTAINERS_CXX11
+    template<> struct radix_key_traits<unsigned long long>: radix_unsigned_key_traits<unsigned long long> {};
+    template<> struct radix_key_traits<long long>: radix_signed_key_traits<long long, unsigned long long> {};
+# endif
+
+    // Strings as their characters; std::string compares them as unsigned
+    // char too.
+    template<>
+    struct radix_key_traits<std::string> {
+        static size_t size(const std::string& key) { return key.size(); }
+        static unsigned char byte(const std::string& key, size_t i) { return static_cast<unsigned char>(key[i]); }
+    };
+
+    // The leaves of a radix_map form a circular list in key order through
+    // the map's header, which is what its iterators walk.
+    struct radix_links {
+        radix_links* prev;
+        radix_links* next;
+    };
+
+    template<class T>
+    struct radix_leaf: radix_links {
+        char storage[sizeof(T)] __attribute__((aligned(__alignof__(T))));
+
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    template<class T, class Ref, class Ptr>
+    class radix_map_iterator {
+    public:
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+        typedef std::bidirectional_iterator_tag iterator_category;
+
+        radix_map_iterator(): _pos(NULL) {}
+        explicit radix_map_iterator( radix_links* pos ): _pos(pos) {}
+        template<class R, class P>
+        radix_map_iterator( const radix_map_iterator<T, R, P>& other ): _pos(other.base()) {}
+
+        reference operator*() const { return *static_cast<radix_leaf<T>*>(_pos)->value(); }
+        pointer operator->() const { return static_cast<radix_leaf<T>*>(_pos)->value(); }
+
+        radix_map_iterator& operator++() {
+            _pos = _pos->next;
+            return *this;
+        }
+        radix_map_iterator operator++(int) {
+            radix_map_iterator tmp(*this);
+            _pos = _pos->next;
+            return tmp;
+        }
+        radix_map_iterator& operator--() {
+            _pos = _pos->prev;
+            return *this;
+        }
+        radix_map_iterator operator--(int) {
+            radix_map_iterator tmp(*this);
+            _pos = _pos->prev;
+            return tmp;
+        }
+
+        template<class R, class P>
+        bool operator==( const radix_map_iterator<T, R, P>& other ) const { return _pos == other.base(); }
+        template<class R, class P>
+        bool operator!=( const radix_map_iterator<T, R, P>& other ) const { return _pos != other.base(); }
+
+        radix_links* base() const { return _pos; }
+
+    private:
+        radix_links* _pos;
+    };
+
+    // Ordered map over an adaptive radix tree (Leis et al., "The Adaptive
+    // Radix Tree", ICDE 2013). Keys are walked a byte at a time, so a lookup
+    // costs at most one node per key byte whatever the size of the map, and
+    // never compares whole keys until it reaches a leaf.
+    //
+    // Inner nodes come in four sizes picked by their number of children:
+    // Node4 and Node16 keep sorted key bytes next to their children (Node16
+    // is searched with one SSE2 compare where available), Node48 maps each
+    // byte to one of 48 slots, and Node256 is indexed directly. Chains of
+    // single-child nodes are folded into a prefix on the node below; up to
+    // _max_prefix bytes of it are stored and checked while descending, and
+    // the rest only against the leaf reached. A key that is a prefix of other
+    // keys, as strings can be, lives in the terminal slot of the node where
+    // it ends.
+    //
+    // Iteration order is that of Traits' bytes, which for the provided
+    // traits is std::less<Key>. Iterators stay valid until their element is
+    // erased.
+    template<
+            class Key,
+            class T,
+            class Traits = radix_key_traits<Key>,
+            class Alloc = std::allocator<ft::pair<const Key, T> >
+            > class radix_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef ft::pair<const Key, T> value_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef std::less<Key> key_compare;
+        typedef Traits key_traits;
+        typedef Alloc allocator_type;
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef typename Alloc::pointer pointer;
+        typedef typename Alloc::const_pointer const_pointer;
+        typedef radix_map_iterator<value_type, value_type&, value_type*> iterator;
+        typedef radix_map_iterator<value_type, const value_type&, const value_type*> const_iterator;
+        typedef reverse_vector_iterator<iterator> reverse_iterator;
+        typedef reverse_vector_iterator<const_iterator> const_reverse_iterator;
+
+        radix_map(): _root(NULL), _size(0), _node_bytes(0), _alloc() { _reset_header(); }
+        explicit radix_map( const allocator_type& alloc ): _root(NULL), _size(0), _node_bytes(0), _alloc(alloc) { _reset_header(); }
+
+        template< class InputIt >
+        radix_map( InputIt first, InputIt last, const allocator_type& alloc = allocator_type() ):
+            _root(NULL), _size(0), _node_bytes(0), _alloc(alloc) {
+            _reset_header();
+            try {
+                insert(first, last);
+            }
+            catch (...) {
+                clear();
+                throw;
+            }
+        }
+
+        radix_map( const radix_map& other ): _root(NULL), _size(0), _node_bytes(0), _alloc(other._alloc) {
+            _reset_header();
+            try {
+                insert(other.begin(), other.end());
+            }
+            catch (...) {
+                clear();
+                throw;
+            }
+        }
+
+        radix_map& operator=( const radix_map& other ) {
+            if (this != &other) {
+                radix_map tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+# if FT_CONTAINERS_CXX11
+        radix_map( radix_map&& other ): _root(NULL), _size(0), _node_bytes(0), _alloc(other._alloc) {
+            _reset_header();
+            swap(other);
+        }
+
+        radix_map& operator=( radix_map&& other ) {
+            if (this != &other) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+# endif
+
+        ~radix_map() { clear(); }
+
+        allocator_type get_allocator() const { return _alloc; }
+
+        iterator begin() { return iterator(_header.next); }
+        const_iterator begin() const { return const_iterator(_header.next); }
+        iterator end() { return iterator(&_header); }
+        const_iterator end() const { return const_iterator(const_cast<radix_links*>(&_header)); }
+        reverse_iterator rbegin() { return reverse_iterator(--end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(--end()); }
+        reverse_iterator rend() { return reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(end()); }
+
+        bool empty() const { return _size == 0; }
+        size_type size() const { return _size; }
+        size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(_leaf); }
+
+        // Leaves count their list links as node overhead, inner nodes count
+        // entirely as node overhead.
+        memory_footprint memory_usage() const {
+            memory_footprint usage;
+            usage.payload = _size * sizeof(value_type);
+            usage.node_overhead = _size * (sizeof(_leaf) - sizeof(value_type)) + _node_bytes;
+            return usage;
+        }
+
+        void clear() {
+            _destroy_tree(_root);
+            _root = NULL;
+            radix_links* pos = _header.next;
+            while (pos != &_header) {
+                radix_links* next = pos->next;
+                _destroy_leaf(static_cast<_leaf*>(pos));
+                pos = next;
+            }
+            _reset_header();
+            _size = 0;
+        }
+
+        ft::pair<iterator, bool> insert( const value_type& value ) {
+            _leaf* next = _lower_bound(_root, value.first, Traits::size(value.first), 0);
+            if (next != NULL && _equal(_key_of(next), value.first))
+                return ft::make_pair(iterator(next), false);
+            return ft::make_pair(iterator(_insert_new(_create_leaf(value), next)), true);
+        }
+
+        iterator insert( iterator hint, const value_type& value ) {
+            (void)hint;
+            return insert(value).first;
+        }
+
+        template< class InputIt >
+        void insert( InputIt first, InputIt last ) {
+            for ( ; first != last ; ++first)
+                insert(*first);
+        }
+
+# if FT_CONTAINERS_CXX11
+        ft::pair<iterator, bool> insert( value_type&& value ) {
+            return emplace(std::move(value));
+        }
+
+        // The element is built first, since its key is needed to place it.
+        template< class... Args >
+        ft::pair<iterator, bool> emplace( Args&&... args ) {
+            _leaf* leaf = _allocate_leaf();
+            try {
+                ::new (static_cast<void*>(leaf->value())) value_type(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                _deallocate_leaf(leaf);
+                throw;
+            }
+            const Key& key = _key_of(leaf);
+            _leaf* next = _lower_bound(_root, key, Traits::size(key), 0);
+            if (next != NULL && _equal(_key_of(next), key)) {
+                _destroy_leaf(leaf);
+                return ft::make_pair(iterator(next), false);
+            }
+            return ft::make_pair(iterator(_insert_new(leaf, next)), true);
+        }
+
+        template< class... Args >
+        iterator emplace_hint( iterator hint, Args&&... args ) {
+            (void)hint;
+            return emplace(std::forward<Args>(args)...).first;
+        }
+# endif
+
+        void erase( iterator pos ) {
+            _leaf* leaf = static_cast<_leaf*>(pos.base());
+            _unlink_key(_key_of(leaf));
+            _unlink(leaf);
+            _destroy_leaf(leaf);
+            --_size;
+        }
+
+        void erase( iterator first, iterator last ) {
+            while (first != last)
+                erase(first++);
+        }
+
+        size_type erase( const Key& key ) {
+            _leaf* leaf = _unlink_key(key);
+            if (leaf == NULL)
+                return 0;
+            _unlink(leaf);
+            _destroy_leaf(leaf);
+            --_size;
+            return 1;
+        }
+
+        void swap( radix_map& other ) {
+            std::swap(_root, other._root);
+            std::swap(_size, other._size);
+            std::swap(_node_bytes, other._node_bytes);
+            std::swap(_alloc, other._alloc);
+            std::swap(_header, other._header);
+            _fix_header();
+            other._fix_header();
+        }
+
+        size_type count( const Key& key ) const { return _search(key) != NULL; }
+
+        iterator find( const Key& key ) {
+            _leaf* leaf = _search(key);
+            return leaf != NULL ? iterator(leaf) : end();
+        }
+        const_iterator find( const Key& key ) const {
+            _leaf* leaf = _search(key);
+            return leaf != NULL ? const_iterator(leaf) : end();
+        }
+
+        T& at( const Key& key ) {
+            _leaf* leaf = _search(key);
+            if (leaf == NULL)
+                throw std::out_of_range("Key Error: No such key in radix_map");
+            return leaf->value()->second;
+        }
+        const T& at( const Key& key ) const {
+            _leaf* leaf = _search(key);
+            if (leaf == NULL)
+                throw std::out_of_range("Key Error: No such key in radix_map");
+            return leaf->value()->second;
+        }
+
+        T& operator[]( const Key& key ) {
+            _leaf* leaf = _search(key);
+            if (leaf != NULL)
+                return leaf->value()->second;
+            return insert(value_type(key, T())).first->second;
+        }
+
+        iterator lower_bound( const Key& key ) { return _as_iterator(_lower_bound(_root, key, Traits::size(key), 0)); }
+        const_iterator lower_bound( const Key& key ) const { return _as_iterator(_lower_bound(_root, key, Traits::size(key), 0)); }
+        iterator upper_bound( const Key& key ) { return _as_iterator(_upper_bound(key)); }
+        const_iterator upper_bound( const Key& key ) const { return _as_iterator(_upper_bound(key)); }
+
+        ft::pair<iterator, iterator> equal_range( const Key& key ) {
+            return ft::make_pair(lower_bound(key), upper_bound(key));
+        }
+        ft::pair<const_iterator, const_iterator> equal_range( const Key& key ) const {
+            return ft::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        key_compare key_comp() const { return key_compare(); }
+
+    private:
+        typedef radix_leaf<value_type> _leaf;
+        typedef typename Alloc::template rebind<_leaf>::other leaf_allocator_type;
+
+        static const size_t _max_prefix = 8;
+        enum { _type4, _type16, _type48, _type256 };
+
+        // Children are node pointers, or leaf pointers with the low bit set.
+        struct _node {
+            unsigned char type;
+            unsigned short count;
+            uint32_t prefix_len;
+            unsigned char prefix[_max_prefix];
+            _leaf* terminal;
+        };
+        struct _node4: _node {
+            unsigned char keys[4];
+            _node* children[4];
+        };
+        struct _node16: _node {
+            unsigned char keys[16];
+            _node* children[16];
+        };
+        struct _node48: _node {
+            unsigned char index[256];       // slot + 1, 0 when absent
+            _node* children[48];
+        };
+        struct _node256: _node {
+            _node* children[256];
+        };
+
+        _node* _root;
+        size_type _size;
+        size_type _node_bytes;
+        radix_links _header;
+        allocator_type _alloc;
+
+        static bool _is_leaf( const _node* n ) { return reinterpret_cast<uintptr_t>(n) & 1; }
+        static _leaf* _as_leaf( const _node* n ) { return reinterpret_cast<_leaf*>(reinterpret_cast<uintptr_t>(n) & ~uintptr_t(1)); }
+        static _node* _tagged( _leaf* leaf ) { return reinterpret_cast<_node*>(reinterpret_cast<uintptr_t>(leaf) | 1); }
+        static const Key& _key_of( _leaf* leaf ) { return leaf->value()->first; }
+        static size_t _min( size_t a, size_t b ) { return a < b ? a : b; }
+
+        static bool _equal( const Key& a, const Key& b ) {
+            size_t len = Traits::size(a);
+            if (len != Traits::size(b))
+                return false;
+            for (size_t i = 0; i < len; ++i)
+                if (Traits::byte(a, i) != Traits::byte(b, i))
+                    return false;
+            return true;
+        }
+
+        // Whether a >= b, given that their first depth bytes are equal.
+        static bool _not_less( const Key& a, const Key& b, size_t depth ) {
+            size_t alen = Traits::size(a);
+            size_t blen = Traits::size(b);
+            size_t len = _min(alen, blen);
+            for (size_t i = depth; i < len; ++i) {
+                unsigned char x = Traits::byte(a, i);
+                unsigned char y = Traits::byte(b, i);
+                if (x != y)
+                    return x > y;
+            }
+            return alen >= blen;
+        }
+
+        iterator _as_iterator( _leaf* leaf ) { return leaf != NULL ? iterator(leaf) : end(); }
+        const_iterator _as_iterator( _leaf* leaf ) const { return leaf != NULL ? const_iterator(leaf) : end(); }
+
+        // List
+
+        void _reset_header() {
+            _header.prev = &_header;
+            _header.next = &_header;
+        }
+
+        // After the header was copied from elsewhere, points its neighbours
+        // back at it.
+        void _fix_header() {
+            if (_size == 0)
+                _reset_header();
+            else {
+                _header.next->prev = &_header;
+                _header.prev->next = &_header;
+            }
+        }
+
+        void _link_before( radix_links* pos, _leaf* leaf ) {
+            leaf->next = pos;
+            leaf->prev = pos->prev;
+            pos->prev->next = leaf;
+            pos->prev = leaf;
+        }
+
+        static void _unlink( _leaf* leaf ) {
+            leaf->prev->next = leaf->next;
+            leaf->next->prev = leaf->prev;
+        }
+
+        // Allocation
+
+        _leaf* _allocate_leaf() {
+            leaf_allocator_type alloc(_alloc);
+            return alloc.allocate(1);
+        }
+
+        void _deallocate_leaf( _leaf* leaf ) {
+            leaf_allocator_type alloc(_alloc);
+            alloc.deallocate(leaf, 1);
+        }
+
+        _leaf* _create_leaf( const value_type& value ) {
+            _leaf* leaf = _allocate_leaf();
+            try {
+                _alloc.construct(leaf->value(), value);
+            }
+            catch (...) {
+                _deallocate_leaf(leaf);
+                throw;
+            }
+            return leaf;
+        }
+
+        void _destroy_leaf( _leaf* leaf ) {
+            _alloc.destroy(leaf->value());
+            _deallocate_leaf(leaf);
+        }
+
+        template<class N>
+        N* _allocate_node( unsigned char type ) {
+            typename Alloc::template rebind<N>::other alloc(_alloc);
+            N* n = alloc.allocate(1);
+            std::memset(static_cast<void*>(n), 0, sizeof(N));
+            n->type = type;
+            _node_bytes += sizeof(N);
+            return n;
+        }
+
+        template<class N>
+        void _deallocate_node( N* n ) {
+            typename Alloc::template rebind<N>::other alloc(_alloc);
+            alloc.deallocate(n, 1);
+            _node_bytes -= sizeof(N);
+        }
+
+        void _free_node( _node* n ) {
+            switch (n->type) {
+                case _type4: _deallocate_node(static_cast<_node4*>(n)); break;
+                case _type16: _deallocate_node(static_cast<_node16*>(n)); break;
+                case _type48: _deallocate_node(static_cast<_node48*>(n)); break;
+                default: _deallocate_node(static_cast<_node256*>(n)); break;
+            }
+        }
+
+        // Inner nodes only: the leaves are freed through the list.
+        void _destroy_tree( _node* n ) {
+            if (n == NULL || _is_leaf(n))
+                return ;
+            for (int b = _byte_after(n, -1); b >= 0; b = _byte_after(n, b))
+                _destroy_tree(*_find_child(n, static_cast<unsigned char>(b)));
+            _free_node(n);
+        }
+
+        static void _copy_header( _node* to, const _node* from ) {
+            to->count = from->count;
+            to->prefix_len = from->prefix_len;
+            std::memcpy(to->prefix, from->prefix, _max_prefix);
+            to->terminal = from->terminal;
+        }
+
+        // Children
+
+        static _node** _find_child( _node* n, unsigned char b ) {
+            switch (n->type) {
+                case _type4: {
+                    _node4* p = static_cast<_node4*>(n);
+                    for (unsigned i = 0; i < p->count; ++i)
+                        if (p->keys[i] == b)
+                            return &p->children[i];
+                    return NULL;
+                }
+                case _type16: {
+                    _node16* p = static_cast<_node16*>(n);
+# if defined(__SSE2__)
+                    __m128i hits = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(b)),
+                                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(p->keys)));
+                    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits)) & ((1u << p->count) - 1);
+                    return mask != 0 ? &p->children[__builtin_ctz(mask)] : NULL;
+# else
+                    for (unsigned i = 0; i < p->count; ++i)
+                        if (p->keys[i] == b)
+                            return &p->children[i];
+                    return NULL;
+# endif
+                }
+                case _type48: {
+                    _node48* p = static_cast<_node48*>(n);
+                    return p->index[b] != 0 ? &p->children[p->index[b] - 1] : NULL;
+                }
+                default: {
+                    _node256* p = static_cast<_node256*>(n);
+                    return p->children[b] != NULL ? &p->children[b] : NULL;
+                }
+            }
+        }
+
+        // The smallest key byte above b that has a child, or -1.
+        static int _byte_after( const _node* n, int b ) {
+            switch (n->type) {
+                case _type4: {
+                    const _node4* p = static_cast<const _node4*>(n);
+                    for (unsigned i = 0; i < p->count; ++i)
+                        if (p->keys[i] > b)
+                            return p->keys[i];
+                    return -1;
+                }
+                case _type16: {
+                    const _node16* p = static_cast<const _node16*>(n);
+                    for (unsigned i = 0; i < p->count; ++i)
+                        if (p->keys[i] > b)
+                            return p->keys[i];
+                    return -1;
+                }
+                case _type48: {
+                    const _node48* p = static_cast<const _node48*>(n);
+                    for (int c = b + 1; c < 256; ++c)
+                        if (p->index[c] != 0)
+                            return c;
+                    return -1;
+                }
+                default: {
+                    const _node256* p = static_cast<const _node256*>(n);
+                    for (int c = b + 1; c < 256; ++c)
+                        if (p->children[c] != NULL)
+                            return c;
+                    return -1;
+                }
+            }
+        }
+
+        // Inserts into a sorted key array with room left.
+        template<class N>
+        static void _insert_sorted( N* p, unsigned char b, _node* child ) {
+            unsigned i = 0;
+            while (i < p->count && p->keys[i] < b)
+                ++i;
+            std::memmove(p->keys + i + 1, p->keys + i, p->count - i);
+            std::memmove(p->children + i + 1, p->children + i, (p->count - i) * sizeof(_node*));
+            p->keys[i] = b;
+            p->children[i] = child;
+            ++p->count;
+        }
+
+        // Adds a child to *ref, replacing it with the next larger node type
+        // when it is full. Allocates before touching the tree.
+        void _add_child( _node** ref, unsigned char b, _node* child ) {
+            _node* n = *ref;
+            switch (n->type) {
+                case _type4: {
+                    _node4* p = static_cast<_node4*>(n);
+                    if (p->count < 4)
+                        return _insert_sorted(p, b, child);
+                    _node16* grown = _allocate_node<_node16>(_type16);
+                    _copy_header(grown, p);
+                    std::memcpy(grown->keys, p->keys, 4);
+                    std::memcpy(grown->children, p->children, 4 * sizeof(_node*));
+                    _deallocate_node(p);
+                    *ref = grown;
+                    return _insert_sorted(grown, b, child);
+                }
+                case _type16: {
+                    _node16* p = static_cast<_node16*>(n);
+                    if (p->count < 16)
+                        return _insert_sorted(p, b, child);
+                    _node48* grown = _allocate_node<_node48>(_type48);
+                    _copy_header(grown, p);
+                    for (unsigned i = 0; i < 16; ++i) {
+                        grown->index[p->keys[i]] = static_cast<unsigned char>(i + 1);
+                        grown->children[i] = p->children[i];
+                    }
+                    _deallocate_node(p);
+                    *ref = grown;
+                    grown->index[b] = 17;
+                    grown->children[16] = child;
+                    ++grown->count;
+                    return ;
+                }
+                case _type48: {
+                    _node48* p = static_cast<_node48*>(n);
+                    if (p->count < 48) {
+                        unsigned slot = 0;
+                        while (p->children[slot] != NULL)
+                            ++slot;
+                        p->index[b] = static_cast<unsigned char>(slot + 1);
+                        p->children[slot] = child;
+                        ++p->count;
+                        return ;
+                    }
+                    _node256* grown = _allocate_node<_node256>(_type256);
+                    _copy_header(grown, p);
+                    for (int c = 0; c < 256; ++c)
+                        if (p->index[c] != 0)
+                            grown->children[c] = p->children[p->index[c] - 1];
+                    _deallocate_node(p);
+                    *ref = grown;
+                    grown->children[b] = child;
+                    ++grown->count;
+                    return ;
+                }
+                default: {
+                    _node256* p = static_cast<_node256*>(n);
+                    p->children[b] = child;
+                    ++p->count;
+                    return ;
+                }
+            }
+        }
+
+        // Removes the child at slot, then moves *ref to a smaller node type
+        // once it is sparse enough. Shrinking is skipped, to be retried on a
+        // later erase, if the smaller node cannot be allocated.
+        void _remove_child( _node** ref, unsigned char b, _node** slot ) {
+            _node* n = *ref;
+            switch (n->type) {
+                case _type4:
+                    _remove_sorted(static_cast<_node4*>(n), slot);
+                    break;
+                case _type16: {
+                    _node16* p = static_cast<_node16*>(n);
+                    _remove_sorted(p, slot);
+                    if (p->count <= 3) {
+                        _node4* shrunk = _try_allocate_node<_node4>(_type4);
+                        if (shrunk != NULL) {
+                            _copy_header(shrunk, p);
+                            std::memcpy(shrunk->keys, p->keys, p->count);
+                            std::memcpy(shrunk->children, p->children, p->count * sizeof(_node*));
+                            _deallocate_node(p);
+                            *ref = shrunk;
+                        }
+                    }
+                    break;
+                }
+                case _type48: {
+                    _node48* p = static_cast<_node48*>(n);
+                    *slot = NULL;
+                    p->index[b] = 0;
+                    --p->count;
+                    if (p->count <= 12) {
+                        _node16* shrunk = _try_allocate_node<_node16>(_type16);
+                        if (shrunk != NULL) {
+                            _copy_header(shrunk, p);
+                            shrunk->count = 0;
+                            for (int c = 0; c < 256; ++c)
+                                if (p->index[c] != 0) {
+                                    shrunk->keys[shrunk->count] = static_cast<unsigned char>(c);
+                                    shrunk->children[shrunk->count++] = p->children[p->index[c] - 1];
+                                }
+                            _deallocate_node(p);
+                            *ref = shrunk;
+                        }
+                    }
+                    break;
+                }
+                default: {
+                    _node256* p = static_cast<_node256*>(n);
+                    *slot = NULL;
+                    --p->count;
+                    if (p->count <= 37) {
+                        _node48* shrunk = _try_allocate_node<_node48>(_type48);
+                        if (shrunk != NULL) {
+                            _copy_header(shrunk, p);
+                            shrunk->count = 0;
+                            for (int c = 0; c < 256; ++c)
+                                if (p->children[c] != NULL) {
+                                    shrunk->index[c] = static_cast<unsigned char>(shrunk->count + 1);
+                                    shrunk->children[shrunk->count++] = p->children[c];
+                                }
+                            _deallocate_node(p);
+                            *ref = shrunk;
+                        }
+                    }
+                    break;
+                }
+            }
+            _collapse(ref);
+        }
+
+        template<class N>
+        static void _remove_sorted( N* p, _node** slot ) {
+            unsigned i = static_cast<unsigned>(slot - p->children);
+            std::memmove(p->keys + i, p->keys + i + 1, p->count - i - 1);
+            std::memmove(p->children + i, p->children + i + 1, (p->count - i - 1) * sizeof(_node*));
+            --p->count;
+        }
+
+        template<class N>
+        N* _try_allocate_node( unsigned char type ) {
+            try {
+                return _allocate_node<N>(type);
+            }
+            catch (...) {
+                return NULL;
+            }
+        }
+
+        // A node left with only its terminal leaf is replaced by that leaf,
+        // and one left with a single child and no terminal is folded into
+        // the child's prefix.
+        void _collapse( _node** ref ) {
+            _node* n = *ref;
+            if (n->count == 0) {
+                *ref = _tagged(n->terminal);
+                _free_node(n);
+                return ;
+            }
+            if (n->count != 1 || n->terminal != NULL)
+                return ;
+            unsigned char b = static_cast<unsigned char>(_byte_after(n, -1));
+            _node* child = *_find_child(n, b);
+            if (!_is_leaf(child)) {
+                unsigned char prefix[_max_prefix];
+                size_t len = _min(n->prefix_len, _max_prefix);
+                std::memcpy(prefix, n->prefix, len);
+                if (len < _max_prefix)
+                    prefix[len++] = b;
+                size_t more = _min(child->prefix_len, _max_prefix - len);
+                std::memcpy(prefix + len, child->prefix, more);
+                std::memcpy(child->prefix, prefix, len + more);
+                child->prefix_len += n->prefix_len + 1;
+            }
+            *ref = child;
+            _free_node(n);
+        }
+
+        // Prefixes
+
+        // How many of the stored prefix bytes of n match key at depth.
+        static size_t _check_prefix( const _node* n, const Key& key, size_t len, size_t depth ) {
+            size_t stored = _min(_min(n->prefix_len, _max_prefix), len - depth);
+            for (size_t i = 0; i < stored; ++i)
+                if (n->prefix[i] != Traits::byte(key, depth + i))
+                    return i;
+            return stored;
+        }
+
+        // How many bytes of the whole prefix of n match key at depth, going
+        // to a leaf below n for those that are not stored. Stops at the end
+        // of the key.
+        static size_t _prefix_mismatch( const _node* n, const Key& key, size_t len, size_t depth ) {
+            size_t limit = _min(n->prefix_len, len - depth);
+            size_t stored = _min(limit, _max_prefix);
+            size_t i = 0;
+            for ( ; i < stored; ++i)
+                if (n->prefix[i] != Traits::byte(key, depth + i))
+                    return i;
+            if (limit > _max_prefix) {
+                const Key& other = _key_of(_minimum(const_cast<_node*>(n)));
+                for ( ; i < limit; ++i)
+                    if (Traits::byte(other, depth + i) != Traits::byte(key, depth + i))
+                        return i;
+            }
+            return i;
+        }
+
+        // Byte i of the prefix of n, found at depth.
+        static unsigned char _prefix_byte( const _node* n, size_t depth, size_t i ) {
+            if (i < _max_prefix)
+                return n->prefix[i];
+            return Traits::byte(_key_of(_minimum(const_cast<_node*>(n))), depth + i);
+        }
+
+        // Lookups
+
+        static _leaf* _minimum( _node* n ) {
+            while (!_is_leaf(n)) {
+                if (n->terminal != NULL)
+                    return n->terminal;
+                n = *_find_child(n, static_cast<unsigned char>(_byte_after(n, -1)));
+            }
+            return _as_leaf(n);
+        }
+
+        // Only the stored prefix bytes are compared on the way down; the
+        // leaf reached is checked against the whole key.
+        _leaf* _search( const Key& key ) const {
+            size_t len = Traits::size(key);
+            size_t depth = 0;
+            _node* n = _root;
+            while (n != NULL) {
+                if (_is_leaf(n)) {
+                    _leaf* leaf = _as_leaf(n);
+                    return _equal(_key_of(leaf), key) ? leaf : NULL;
+                }
+                if (n->prefix_len != 0) {
+                    if (_check_prefix(n, key, len, depth) != _min(n->prefix_len, _max_prefix))
+                        return NULL;
+                    depth += n->prefix_len;
+                    if (depth > len)
+                        return NULL;
+                }
+                if (depth == len)
+                    return n->terminal != NULL && _equal(_key_of(n->terminal), key) ? n->terminal : NULL;
+                _node** child = _find_child(n, Traits::byte(key, depth));
+                if (child == NULL)
+                    return NULL;
+                n = *child;
+                ++depth;
+            }
+            return NULL;
+        }
+
+        // The first leaf under n not less than key, the first depth bytes of
+        // everything under n being equal to key's.
+        static _leaf* _lower_bound( _node* n, const Key& key, size_t len, size_t depth ) {
+            if (n == NULL)
+                return NULL;
+            if (_is_leaf(n)) {
+                _leaf* leaf = _as_leaf(n);
+                return _not_less(_key_of(leaf), key, depth) ? leaf : NULL;
+            }
+            if (n->prefix_len != 0) {
+                size_t same = _prefix_mismatch(n, key, len, depth);
+                if (same < n->prefix_len) {
+                    if (depth + same == len || _prefix_byte(n, depth, same) > Traits::byte(key, depth + same))
+                        return _minimum(n);
+                    return NULL;
+                }
+                depth += n->prefix_len;
+            }
+            // A terminal leaf here is a proper prefix of key, so smaller.
+            if (depth == len)
+                return _minimum(n);
+            unsigned char b = Traits::byte(key, depth);
+            _node** child = _find_child(n, b);
+            if (child != NULL) {
+                _leaf* found = _lower_bound(*child, key, len, depth + 1);
+                if (found != NULL)
+                    return found;
+            }
+            int next = _byte_after(n, b);
+            return next >= 0 ? _minimum(*_find_child(n, static_cast<unsigned char>(next))) : NULL;
+        }
+
+        _leaf* _upper_bound( const Key& key ) const {
+            _leaf* leaf = _lower_bound(_root, key, Traits::size(key), 0);
+            if (leaf != NULL && _equal(_key_of(leaf), key)) {
+                radix_links* next = leaf->next;
+                return next != &_header ? static_cast<_leaf*>(next) : NULL;
+            }
+            return leaf;
+        }
+
+        // Updates
+
+        // Links a leaf whose key is not in the map yet into the tree and in
+        // front of next (its successor, or NULL for the end) in the list.
+        _leaf* _insert_new( _leaf* leaf, _leaf* next ) {
+            try {
+                _insert_leaf(leaf);
+            }
+            catch (...) {
+                _destroy_leaf(leaf);
+                throw;
+            }
+            _link_before(next != NULL ? static_cast<radix_links*>(next) : &_header, leaf);
+            ++_size;
+            return leaf;
+        }
+
+        void _insert_leaf( _leaf* leaf ) {
+            const Key& key = _key_of(leaf);
+            size_t len = Traits::size(key);
+            size_t depth = 0;
+            _node** ref = &_root;
+            for (;;) {
+                _node* n = *ref;
+                if (n == NULL) {
+                    *ref = _tagged(leaf);
+                    return ;
+                }
+                if (_is_leaf(n)) {
+                    // Two leaves: split below their common bytes.
+                    _leaf* other = _as_leaf(n);
+                    const Key& other_key = _key_of(other);
+                    size_t other_len = Traits::size(other_key);
+                    size_t limit = _min(len, other_len);
+                    size_t same = 0;
+                    while (depth + same < limit && Traits::byte(key, depth + same) == Traits::byte(other_key, depth + same))
+                        ++same;
+                    _node4* split = _allocate_node<_node4>(_type4);
+                    split->prefix_len = static_cast<uint32_t>(same);
+                    for (size_t i = 0; i < _min(same, _max_prefix); ++i)
+                        split->prefix[i] = Traits::byte(key, depth + i);
+                    depth += same;
+                    _hang(split, other, other_key, other_len, depth);
+                    _hang(split, leaf, key, len, depth);
+                    *ref = split;
+                    return ;
+                }
+                if (n->prefix_len != 0) {
+                    size_t same = _prefix_mismatch(n, key, len, depth);
+                    if (same < n->prefix_len) {
+                        // The key leaves the prefix: split it there.
+                        _node4* split = _allocate_node<_node4>(_type4);
+                        split->prefix_len = static_cast<uint32_t>(same);
+                        std::memcpy(split->prefix, n->prefix, _min(same, _max_prefix));
+                        unsigned char b;
+                        if (n->prefix_len <= _max_prefix) {
+                            b = n->prefix[same];
+                            n->prefix_len -= static_cast<uint32_t>(same + 1);
+                            std::memmove(n->prefix, n->prefix + same + 1, n->prefix_len);
+                        }
+                        else {
+                            const Key& below = _key_of(_minimum(n));
+                            b = Traits::byte(below, depth + same);
+                            n->prefix_len -= static_cast<uint32_t>(same + 1);
+                            for (size_t i = 0; i < _min(n->prefix_len, _max_prefix); ++i)
+                                n->prefix[i] = Traits::byte(below, depth + same + 1 + i);
+                        }
+                        _insert_sorted(split, b, n);
+                        _hang(split, leaf, key, len, depth + same);
+                        *ref = split;
+                        return ;
+                    }
+                    depth += n->prefix_len;
+                }
+                if (depth == len) {
+                    n->terminal = leaf;
+                    return ;
+                }
+                _node** child = _find_child(n, Traits::byte(key, depth));
+                if (child == NULL)
+                    return _add_child(ref, Traits::byte(key, depth), _tagged(leaf));
+                ref = child;
+                ++depth;
+            }
+        }
+
+        // Puts a leaf under a fresh split node whose prefix ends at depth.
+        static void _hang( _node4* split, _leaf* leaf, const Key& key, size_t len, size_t depth ) {
+            if (depth == len)
+                split->terminal = leaf;
+            else
+                _insert_sorted(split, Traits::byte(key, depth), _tagged(leaf));
+        }
+
+        // Takes the leaf holding key out of the tree, but not the list.
+        _leaf* _unlink_key( const Key& key ) {
+            size_t len = Traits::size(key);
+            size_t depth = 0;
+            _node** ref = &_root;
+            for (;;) {
+                _node* n = *ref;
+                if (n == NULL)
+                    return NULL;
+                if (_is_leaf(n)) {
+                    _leaf* leaf = _as_leaf(n);
+                    if (!_equal(_key_of(leaf), key))
+                        return NULL;
+                    *ref = NULL;
+                    return leaf;
+                }
+                if (n->prefix_len != 0) {
+                    if (_check_prefix(n, key, len, depth) != _min(n->prefix_len, _max_prefix))
+                        return NULL;
+                    depth += n->prefix_len;
+                    if (depth > len)
+                        return NULL;
+                }
+                if (depth == len) {
+                    _leaf* leaf = n->terminal;
+                    if (leaf == NULL || !_equal(_key_of(leaf), key))
+                        return NULL;
+                    n->terminal = NULL;
+                    _collapse(ref);
+                    return leaf;
+                }
+                unsigned char b = Traits::byte(key, depth);
+                _node** child = _find_child(n, b);
+                if (child == NULL)
+                    return NULL;
+                if (_is_leaf(*child)) {
+                    _leaf* leaf = _as_leaf(*child);
+                    if (!_equal(_key_of(leaf), key))
+                        return NULL;
+                    _remove_child(ref, b, child);
+                    return leaf;
+                }
+                ref = child;
+                ++depth;
+            }
+        }
+    };
+
+    template< class Key, class T, class Traits, class Alloc >
+    void swap( ft::radix_map<Key,T,Traits,Alloc>& lhs,
+              ft::radix_map<Key,T,Traits,Alloc>& rhs ) {
+        lhs.swap(rhs);
+    }
+
+    template< class Key, class T, class Traits, class Alloc >
+    bool operator==( const ft::radix_map<Key,T,Traits,Alloc>& lhs,
+                    const ft::radix_map<Key,T,Traits,Alloc>& rhs ) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template< class Key, class T, class Traits, class Alloc >
+    bool operator!=( const ft::radix_map<Key,T,Traits,Alloc>& lhs,
+                    const ft::radix_map<Key,T,Traits,Alloc>& rhs ) { return !(lhs == rhs); }
+
+    template< class Key, class T, class Traits, class Alloc >
+    bool operator<( const ft::radix_map<Key,T,Traits,Alloc>& lhs,
+                    const ft::radix_map<Key,T,Traits,Alloc>& rhs ) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template< class Key, class T, class Traits, class Alloc >
+    bool operator>( const ft::radix_map<Key,T,Traits,Alloc>& lhs,
+                   const ft::radix_map<Key,T,Traits,Alloc>& rhs ) { return rhs < lhs; }
+
+    template< class Key, class T, class Traits, class Alloc >
+    bool operator>=( const ft::radix_map<Key,T,Traits,Alloc>& lhs,
+                   const ft::radix_map<Key,T,Traits,Alloc>& rhs ) { return !(lhs < rhs); }
+
+    template< class Key, class T, class Traits, class Alloc >
+    bool operator<=( const ft::radix_map<Key,T,Traits,Alloc>& lhs,
+                    const ft::radix_map<Key,T,Traits,Alloc>& rhs ) { return !(rhs < lhs); }
+}
+
+#endif//FT_CONTAINERS_RADIX_MAP_HPP
@@ -1,13 +1,20 @@
 #ifndef FT_CONTAINERS_SET_HPP
 # define FT_CONTAINERS_SET_HPP
 # include "RedBlackTree.hpp"
+# include "latency.hpp"
+# include "lookup_filter.hpp"
 # include "algorithm.hpp"
 
 namespace ft {
+    // KeyPrefix has nodes cache a prefix of their key, see key_prefix.hpp;
+    // pass key_prefix_traits<Key, Compare> to turn it on.
+    // enable_lookup_filter() adds a Bloom filter that answers most lookups
+    // of absent keys without walking the tree.
     template<
             class Key,
             class Compare = std::less<Key>,
-            class Allocator = std::allocator<Key>>
+            class Allocator = std::allocator<Key>,
+            class KeyPrefix = no_key_prefix >
     class set {
     public:
         typedef Key key_type;
@@ -26,28 +33,43 @@ namespace ft {
         typedef typename RedBlackTree<value_type, Compare>::reverse_iterator reverse_iterator;
         typedef typename RedBlackTree<value_type, Compare>::const_reverse_iterator const_reverse_iterator;
 
-        set() : _comp(value_compare(key_compare())), _tree(_comp) {}
+        set() : _key_comp(), _comp(value_compare(key_compare())), _alloc(), _tree(_comp, _alloc) {}
 
         explicit set(const Compare &comp,
-                     const Allocator &alloc = Allocator()) : _comp(value_compare(comp)), _alloc(alloc), _tree(_comp) {}
+                     const Allocator &alloc = Allocator()) : _key_comp(comp), _comp(value_compare(comp)), _alloc(alloc), _tree(_comp, _alloc) {}
 
         template<class InputIt>
         set(InputIt first, InputIt last,
             const Compare &comp = Compare(),
-            const Allocator &alloc = Allocator()) : _comp(value_compare(comp)), _alloc(alloc), _tree(_comp) {
-            for (; first != last; ++first) {
-                _tree.rbInsert(_tree.newNode(ft::make_pair(*first)));
-            }
+            const Allocator &alloc = Allocator()) : _key_comp(comp), _comp(value_compare(comp)), _alloc(alloc), _tree(_comp, _alloc) {
+            for (; first != last; ++first)
+                _tree.rbInsert(*first);
         }
 
-        set(const set &other) : _tree(other._tree), _comp(value_compare(key_compare())), _alloc(other._alloc) {}
+        set(const set &other) : _key_comp(other._key_comp), _comp(other._comp), _alloc(other._alloc), _tree(other._tree), _filter(other._filter) {}
 
         set &operator=(const set &other) {
-            if (this != &other)
+            if (this != &other) {
                 _tree = other._tree;
+                _filter = other._filter;
+            }
             return *this;
         }
 
+# if FT_CONTAINERS_CXX11
+        set(set &&other) : _key_comp(other._key_comp), _comp(other._comp), _alloc(other._alloc), _tree(std::move(other._tree)) {
+            _filter.swap(other._filter);
+        }
+
+        set &operator=(set &&other) {
+            if (this != &other) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+# endif
+
         ~set() {}
 
         allocator_type get_allocator() const { return _alloc; }
@@ -62,23 +84,75 @@ namespace ft {
         const_reverse_iterator rend() const { return _tree.rend(); }
 
         ft::pair<iterator, bool> insert(const value_type &value) {
-            return _tree.rbInsert(value);
+            FT_LATENCY_SCOPE(latency_set_insert);
+            return _inserted(_tree.rbInsert(value));
         }
 
         iterator insert(iterator hint, const value_type &value) {
-            return _tree.rbInsert(hint, value);
+            FT_LATENCY_SCOPE(latency_set_insert);
+            size_type before = size();
+            iterator pos = _tree.rbInsert(hint, value);
+            if (size() != before)
+                _filter_insert(*pos);
+            return pos;
         }
 
         template<class InputIt>
         void insert(InputIt first, InputIt last) {
-            for (; first != last; ++first)
-                _tree.rbInsert(*first);
+            for (; first != last; ++first) {
+                FT_LATENCY_SCOPE(latency_set_insert);
+                _inserted(_tree.rbInsert(*first));
+            }
+        }
+
+# if FT_CONTAINERS_CXX11
+        ft::pair<iterator, bool> insert(value_type &&value) {
+            FT_LATENCY_SCOPE(latency_set_insert);
+            return _inserted(_tree.rbEmplace(std::move(value)));
+        }
+
+        template<class... Args>
+        ft::pair<iterator, bool> emplace(Args &&... args) {
+            FT_LATENCY_SCOPE(latency_set_insert);
+            return _inserted(_tree.rbEmplace(std::forward<Args>(args)...));
         }
 
+        template<class... Args>
+        iterator emplace_hint(iterator hint, Args &&... args) {
+            (void)hint;
+            FT_LATENCY_SCOPE(latency_set_insert);
+            return _inserted(_tree.rbEmplace(std::forward<Args>(args)...)).first;
+        }
+# endif
+
         size_type size() const { return _tree.size(); }
         size_type max_size() const { return _tree.max_size(); }
+        memory_footprint memory_usage() const {
+            memory_footprint usage = _tree.memory_usage();
+            usage.node_overhead += _filter.memory_usage();
+            return usage;
+        }
+
+        typedef typename lookup_filter<Key>::hasher lookup_hasher;
+
+        // Builds the filter from the keys already in the set; from then on it
+        // follows every insert and erase, and is rebuilt twice as large
+        // whenever the set outgrows it. hash must agree with the comparator,
+        // see lookup_filter.hpp.
+        void enable_lookup_filter(lookup_hasher hash = &lookup_hash<Key>::hash) {
+            lookup_filter<Key> filter;
+            _build_filter(filter, hash);
+            _filter.swap(filter);
+        }
+
+        void disable_lookup_filter() { _filter.disable(); }
+        bool lookup_filter_enabled() const { return _filter.enabled(); }
+
+        bool contains(const Key &key) const { return count(key) != 0; }
 
         size_type count(const Key &key) const {
+            if (!_filter.may_contain(key))
+                return 0;
             node_ptr elem = _tree.search(key);
             if (elem->is_nil)
                 return 0;
@@ -86,14 +160,21 @@ namespace ft {
                 return 1;
         }
         iterator find(const Key &key) {
+            FT_LATENCY_SCOPE(latency_set_find);
+            if (!_filter.may_contain(key))
+                return end();
             return iterator(_tree.search(key));
         }
         const_iterator find( const Key& key ) const {
+            FT_LATENCY_SCOPE(latency_set_find);
+            if (!_filter.may_contain(key))
+                return end();
             return const_iterator(_tree.search(key));
         }
 
         void clear() {
             _tree.clearTree();
+            _filter.clear();
         }
 
         bool empty() const { return size() == 0; }
@@ -101,6 +182,9 @@ namespace ft {
         set::value_compare value_comp() const { return _comp; }
 
         void erase(iterator pos) {
+            FT_LATENCY_SCOPE(latency_set_erase);
+            if (_filter.enabled())
+                _filter.erase(*pos);
             _tree.rbDelete(pos.base());
         }
 
@@ -147,54 +231,92 @@ namespace ft {
             std::swap(_key_comp, other._key_comp);
             std::swap(_comp, other._comp);
             std::swap(_alloc, other._alloc);
+            _filter.swap(other._filter);
         }
 
     private:
         typedef Node<value_type> *node_ptr;
-        RedBlackTree<value_type, value_compare> _tree;
+        typedef ft::RedBlackTree<value_type, value_compare, Allocator, KeyPrefix> tree_type;
+        typedef char key_prefix_must_be_no_key_prefix_or_key_prefix_traits_of_key_and_compare[
+                key_prefix_fits<KeyPrefix, Key, Compare>::value ? 1 : -1];
+        // The tree is built from the members above it, so it comes last.
         key_compare _key_comp;
         value_compare _comp;
         allocator_type _alloc;
+        tree_type _tree;
+        lookup_filter<Key> _filter;
+
+        tree_type &tree() { return _tree; }
 
-        ft::RedBlackTree<value_type, value_compare> &tree() { return _tree; }
+        ft::pair<iterator, bool> _inserted(const ft::pair<iterator, bool> &result) {
+            if (result.second)
+                _filter_insert(*result.first);
+            return result;
+        }
+
+        void _filter_insert(const Key &key) {
+            if (!_filter.enabled())
+                return;
+            _filter.insert(key);
+            if (size() > _filter.capacity())
+                _grow_filter();
+        }
+
+        // Rebuilding also drops counters stuck at their maximum. If the
+        // larger filter cannot be allocated the current one stays, which
+        // still holds every key, only with more false positives.
+        void _grow_filter() {
+            lookup_filter<Key> filter;
+            try {
+                _build_filter(filter, _filter.hash_function());
+            } catch (std::bad_alloc &) {
+                return;
+            }
+            _filter.swap(filter);
+        }
+
+        void _build_filter(lookup_filter<Key> &filter, lookup_hasher hash) const {
+            filter.enable(hash, 2 * size());
+            for (const_iterator it = begin(); it != end(); ++it)
+                filter.insert(*it);
+        }
     };
 
-    template<class Key, class Compare, class Alloc>
-    void swap(ft::set<Key, Compare, Alloc> &lhs,
-              ft::set<Key, Compare, Alloc> &rhs) {
+    template<class Key, class Compare, class Alloc, class KeyPrefix>
+    void swap(ft::set<Key, Compare, Alloc, KeyPrefix> &lhs,
+              ft::set<Key, Compare, Alloc, KeyPrefix> &rhs) {
         lhs.swap(rhs);
     }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator==(const ft::set<Key, Compare, Alloc> &lhs,
-                    const ft::set<Key, Compare, Alloc> &rhs) {
+    template<class Key, class Compare, class Alloc, class KeyPrefix>
+    bool operator==(const ft::set<Key, Compare, Alloc, KeyPrefix> &lhs,
+                    const ft::set<Key, Compare, Alloc, KeyPrefix> &rhs) {
         return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator!=(const ft::set<Key, Compare, Alloc> &lhs,
-                    const ft::set<Key, Compare, Alloc> &rhs) { return !(lhs == rhs); }
+    template<class Key, class Compare, class Alloc, class KeyPrefix>
+    bool operator!=(const ft::set<Key, Compare, Alloc, KeyPrefix> &lhs,
+                    const ft::set<Key, Compare, Alloc, KeyPrefix> &rhs) { return !(lhs == rhs); }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator<(const ft::set<Key, Compare, Alloc> &lhs,
-                   const ft::set<Key, Compare, Alloc> &rhs) {
+    template<class Key, class Compare, class Alloc, class KeyPrefix>
+    bool operator<(const ft::set<Key, Compare, Alloc, KeyPrefix> &lhs,
+                   const ft::set<Key, Compare, Alloc, KeyPrefix> &rhs) {
         return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator>(const ft::set<Key, Compare, Alloc> &lhs,
-                   const ft::set<Key, Compare, Alloc> &rhs) { return rhs < lhs; }
+    template<class Key, class Compare, class Alloc, class KeyPrefix>
+    bool operator>(const ft::set<Key, Compare, Alloc, KeyPrefix> &lhs,
+                   const ft::set<Key, Compare, Alloc, KeyPrefix> &rhs) { return rhs < lhs; }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator>=(const ft::set<Key, Compare, Alloc> &lhs,
-                    const ft::set<Key, Compare, Alloc> &rhs) { return !(rhs < lhs); }
+    template<class Key, class Compare, class Alloc, class KeyPrefix>
+    bool operator>=(const ft::set<Key, Compare, Alloc, KeyPrefix> &lhs,
+                    const ft::set<Key, Compare, Alloc, KeyPrefix> &rhs) { return !(rhs < lhs); }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator<=(const ft::set<Key, Compare, Alloc> &lhs,
-                    const ft::set<Key, Compare, Alloc> &rhs) { return !(lhs < rhs); }
+    template<class Key, class Compare, class Alloc, class KeyPrefix>
+    bool operator<=(const ft::set<Key, Compare, Alloc, KeyPrefix> &lhs,
+                    const ft::set<Key, Compare, Alloc, KeyPrefix> &rhs) { return !(lhs < rhs); }
 
 }
-}
 
 
 #endif//FT_CONTAINERS_SET_HPP
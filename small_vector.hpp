@@ -0,0 +1,419 @@
+#ifndef FT_CONTAINERS_SMALL_VECTOR_HPP
+# define FT_CONTAINERS_SMALL_VECTOR_HPP
+# include <memory>
+# include <cstddef>
+# include <stdexcept>
+# include <limits>
+# include <algorithm>
+# include <iterator>
+# include "algorithm.hpp"
+# include "vector_iterator.hpp"
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+namespace ft {
+// Same interface as ft::vector, but the first N elements live inside the
+// object itself; the allocator is only touched once the size exceeds N.
+template< class T, size_t N, class Alloc = std::allocator<T> >
+class small_vector {
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef reverse_vector_iterator<iterator> reverse_iterator;
+    typedef reverse_vector_iterator<const_iterator> const_reverse_iterator;
+
+    static const size_type inline_capacity = N;
+
+    small_vector(): _size(0), _capacity(N), _array(_inline()), _allocator(allocator_type()) {}
+    explicit small_vector( const allocator_type & alloc ): _size(0), _capacity(N), _array(_inline()), _allocator(alloc) {}
+
+    explicit small_vector( size_type count,
+                          const T& value = T(),
+                          const allocator_type& alloc = allocator_type()): _size(0), _capacity(N), _array(_inline()), _allocator(alloc) {
+        reserve(count);
+        try {
+            _fill(_array, count, value);
+        }
+        catch (...) {
+            _release();
+            throw;
+        }
+        _size = count;
+    }
+
+    template< class InputIt >
+    small_vector( InputIt first, InputIt last, const Alloc& alloc = Alloc(), typename enable_if<!is_integral<InputIt>::value, bool >::type = true ):
+        _size(0), _capacity(N), _array(_inline()), _allocator(alloc) {
+        reserve(std::distance(first, last));
+        try {
+            _size = _copy(first, last, _array) - _array;
+        }
+        catch (...) {
+            _release();
+            throw;
+        }
+    }
+
+    small_vector( const small_vector& other ): _size(0), _capacity(N), _array(_inline()), _allocator(other._allocator) {
+        reserve(other._size);
+        try {
+            _copy(other.begin(), other.end(), _array);
+        }
+        catch (...) {
+            _release();
+            throw;
+        }
+        _size = other._size;
+    }
+
+    ~small_vector() {
+        _destroy_elements();
+        _release();
+    }
+
+    small_vector& operator=( const small_vector& other ) {
+        if (this != &other)
+            assign(other.begin(), other.end());
+        return *this;
+    }
+
+    size_type size() const { return _size; }
+    size_type capacity() const { return _capacity; }
+    allocator_type get_allocator() const { return _allocator; }
+    bool is_inline() const { return _array == _inline(); }
+
+    // Once on the heap, the inline buffer counts as unused capacity too.
+    memory_footprint memory_usage() const {
+        memory_footprint usage;
+        usage.payload = _size * sizeof(T);
+        usage.unused_capacity = (_capacity - _size) * sizeof(T);
+        if (!is_inline())
+            usage.unused_capacity += N * sizeof(T);
+        return usage;
+    }
+
+    void assign( size_type count, const T& value ) {
+        clear();
+        reserve(count);
+        _fill(_array, count, value);
+        _size = count;
+    }
+
+    template< class InputIt >
+    typename enable_if<!is_integral<InputIt>::value, void >::type assign( InputIt first, InputIt last ) {
+        clear();
+        reserve(std::distance(first, last));
+        _size = _copy(first, last, _array) - _array;
+    }
+
+    void reserve( size_type new_cap ) {
+        if (new_cap <= _capacity)
+            return ;
+        _relocate(new_cap);
+    }
+
+    void resize( size_type count, T value = T() ) {
+        if (count > _size) {
+            reserve(count);
+            _fill(_array + _size, count - _size, value);
+            _size = count;
+        }
+        else if (count < _size) {
+            _destroy_elements(count);
+            _size = count;
+        }
+    }
+
+    void push_back( const T& value ) {
+        if (_size == _capacity) {
+            T tmp(value);
+            _relocate(std::max<size_type>(2 * _capacity, 1));
+            _allocator.construct(_array + _size, tmp);
+        }
+        else
+            _allocator.construct(_array + _size, value);
+        ++_size;
+    }
+
+    void pop_back() {
+        --_size;
+        _allocator.destroy(_array + _size);
+    }
+
+    T& operator[]( size_type pos ) { return _array[pos]; }
+    const T& operator[]( size_type pos ) const { return _array[pos]; }
+
+    T& at( size_type pos ) {
+        if (pos >= _size)
+            throw std::out_of_range("Index out of range");
+        return _array[pos];
+    }
+    const T& at( size_type pos ) const {
+        if (pos >= _size)
+            throw std::out_of_range("Index out of range");
+        return _array[pos];
+    }
+
+    T& front() { return _array[0]; }
+    const T& front() const { return _array[0]; }
+    T& back() { return _array[_size - 1]; }
+    const T& back() const { return _array[_size - 1]; }
+    T* data() { return _array; }
+    const T* data() const { return _array; }
+    size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(value_type); }
+    bool empty() const { return _size == 0; }
+
+    void clear() {
+        _destroy_elements();
+        _size = 0;
+    }
+
+    iterator begin() { return iterator(_array); }
+    const_iterator begin() const { return const_iterator(_array); }
+    iterator end() { return iterator(_array + _size); }
+    const_iterator end() const { return const_iterator(_array + _size); }
+    reverse_iterator rbegin() { return reverse_iterator(end() - 1); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end() - 1); }
+    reverse_iterator rend() { return reverse_iterator(begin() - 1); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin() - 1); }
+
+    iterator insert( iterator pos, const T& value ) {
+        size_type index = pos - begin();
+        insert(pos, 1, value);
+        return _array + index;
+    }
+
+    void insert( iterator pos, size_type count, const T& value ) {
+        if (count == 0)
+            return ;
+        size_type index = pos - begin();
+        T tmp(value);
+        if (_size + count > _capacity) {
+            small_vector grown(_allocator);
+            grown.reserve(std::max(_size + count, 2 * _capacity));
+            // grown owns each run as soon as it is built, so a later throw
+            // destroys it with grown.
+            T* p = grown._copy(begin(), begin() + index, grown._array);
+            grown._size = index;
+            p = grown._fill(p, count, tmp);
+            grown._size += count;
+            grown._copy(begin() + index, end(), p);
+            grown._size = _size + count;
+            _adopt(grown);
+            return ;
+        }
+        T* p = _array + index;
+        T* old_end = _array + _size;
+        size_type after = _size - index;
+        if (after > count) {
+            _copy(old_end - count, old_end, old_end);
+            _size += count;
+            std::copy_backward(p, old_end - count, old_end);
+            std::fill(p, p + count, tmp);
+        }
+        else {
+            _fill(old_end, count - after, tmp);
+            _size += count - after;
+            _copy(p, old_end, p + count);
+            _size += after;
+            std::fill(p, old_end, tmp);
+        }
+    }
+
+    template< class InputIt >
+    typename enable_if<!is_integral<InputIt>::value, void >::type insert( iterator pos, InputIt first, InputIt last ) {
+        size_type count = std::distance(first, last);
+        if (count == 0)
+            return ;
+        size_type index = pos - begin();
+        if (_size + count > _capacity) {
+            small_vector grown(_allocator);
+            grown.reserve(std::max(_size + count, 2 * _capacity));
+            T* p = grown._copy(begin(), begin() + index, grown._array);
+            grown._size = index;
+            p = grown._copy(first, last, p);
+            grown._size += count;
+            grown._copy(begin() + index, end(), p);
+            grown._size = _size + count;
+            _adopt(grown);
+            return ;
+        }
+        T* p = _array + index;
+        T* old_end = _array + _size;
+        size_type after = _size - index;
+        if (after > count) {
+            _copy(old_end - count, old_end, old_end);
+            _size += count;
+            std::copy_backward(p, old_end - count, old_end);
+            std::copy(first, last, p);
+        }
+        else {
+            InputIt mid = first;
+            std::advance(mid, after);
+            _copy(mid, last, old_end);
+            _size += count - after;
+            _copy(p, old_end, p + count);
+            _size += after;
+            std::copy(first, mid, p);
+        }
+    }
+
+    iterator erase( iterator pos ) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase( iterator first, iterator last ) {
+        if (first >= last)
+            return last;
+        iterator new_end = std::copy(last, end(), first);
+        _destroy_elements(new_end - _array);
+        _size = new_end - _array;
+        return first;
+    }
+
+    void swap( small_vector& other ) {
+        if (!is_inline() && !other.is_inline()) {
+            std::swap(_size, other._size);
+            std::swap(_capacity, other._capacity);
+            std::swap(_array, other._array);
+            std::swap(_allocator, other._allocator);
+            return ;
+        }
+        small_vector tmp(*this);
+        *this = other;
+        other = tmp;
+    }
+
+private:
+    union storage {
+        unsigned char bytes[sizeof(T) * N];
+        long double align_ld;
+        long long align_ll;
+        void* align_ptr;
+    };
+
+    size_t _size;
+    size_t _capacity;
+    T* _array;
+    allocator_type _allocator;
+    storage _storage;
+
+    T* _inline() { return reinterpret_cast<T*>(_storage.bytes); }
+    const T* _inline() const { return reinterpret_cast<const T*>(_storage.bytes); }
+
+    void _release() {
+        if (!is_inline())
+            _allocator.deallocate(_array, _capacity);
+    }
+
+    // Takes over the heap buffer of other, leaving it empty and inline.
+    void _adopt(small_vector& other) {
+        _destroy_elements();
+        _release();
+        _array = other._array;
+        _size = other._size;
+        _capacity = other._capacity;
+        other._array = other._inline();
+        other._size = 0;
+        other._capacity = N;
+    }
+
+    // Moves the elements into a fresh heap buffer of new_cap slots.
+    void _relocate(size_type new_cap) {
+        T* newarr = _allocator.allocate(new_cap);
+        try {
+            _copy(begin(), end(), newarr);
+        }
+        catch (...) {
+            _allocator.deallocate(newarr, new_cap);
+            throw;
+        }
+        _destroy_elements();
+        _release();
+        _array = newarr;
+        _capacity = new_cap;
+    }
+
+    void _destroy_elements(size_type count = 0) {
+        for (size_t i = count; i < _size; ++i)
+            _allocator.destroy(_array + i);
+    }
+
+    void _destroy_temp_arr(T* start, T* end) {
+        for ( ; start != end ; ++start)
+            _allocator.destroy(start);
+    }
+
+    template<class It>
+    T* _copy(It begin, It end, T* p) {
+        T* ps = p;
+        try {
+            for ( ; begin != end ; ++begin, ++p)
+                _allocator.construct(p, *begin);
+        }
+        catch (...) {
+            _destroy_temp_arr(ps, p);
+            throw;
+        }
+        return p;
+    }
+
+    T* _fill(T* p, size_type n, const T& value) {
+        T* ps = p;
+        try {
+            for (; n != 0; --n, ++p)
+                _allocator.construct(p, value);
+        }
+        catch (...) {
+            _destroy_temp_arr(ps, p);
+            throw;
+        }
+        return p;
+    }
+};
+
+template< class T, size_t N, class Alloc >
+const typename small_vector<T,N,Alloc>::size_type small_vector<T,N,Alloc>::inline_capacity;
+
+template< class T, size_t N, class Alloc >
+bool operator==( const ft::small_vector<T,N,Alloc>& lhs,
+                const ft::small_vector<T,N,Alloc>& rhs ) {
+    return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template< class T, size_t N, class Alloc >
+bool operator!=( const ft::small_vector<T,N,Alloc>& lhs,
+                const ft::small_vector<T,N,Alloc>& rhs ) { return !(lhs == rhs); }
+
+template< class T, size_t N, class Alloc >
+bool operator<( const ft::small_vector<T,N,Alloc>& lhs,
+               const ft::small_vector<T,N,Alloc>& rhs ) {
+    return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template< class T, size_t N, class Alloc >
+bool operator>( const ft::small_vector<T,N,Alloc>& lhs,
+               const ft::small_vector<T,N,Alloc>& rhs ) { return rhs < lhs; }
+
+template< class T, size_t N, class Alloc >
+bool operator<=( const ft::small_vector<T,N,Alloc>& lhs,
+                const ft::small_vector<T,N,Alloc>& rhs ) { return !(rhs < lhs); }
+
+template< class T, size_t N, class Alloc >
+bool operator>=( const ft::small_vector<T,N,Alloc>& lhs,
+                const ft::small_vector<T,N,Alloc>& rhs ) { return !(lhs < rhs); }
+
+template< class T, size_t N, class Alloc >
+void swap( ft::small_vector<T,N,Alloc>& lhs,
+          ft::small_vector<T,N,Alloc>& rhs ) { lhs.swap(rhs); }
+}
+
+#endif//FT_CONTAINERS_SMALL_VECTOR_HPP
@@ -0,0 +1,377 @@
+#ifndef FT_CONTAINERS_SOA_VECTOR_HPP
+# define FT_CONTAINERS_SOA_VECTOR_HPP
+# include "type_traits.hpp"
+# if FT_CONTAINERS_CXX11
+#  include <cstddef>
+#  include <tuple>
+#  include <iterator>
+#  include <stdexcept>
+#  include <utility>
+#  include "vector.hpp"
+
+namespace ft {
+    template<size_t... I>
+    struct _index_sequence {};
+
+    template<size_t N, size_t... I>
+    struct _make_index_sequence: _make_index_sequence<N - 1, N - 1, I...> {};
+
+    template<size_t... I>
+    struct _make_index_sequence<0, I...> { typedef _index_sequence<I...> type; };
+
+    template<class... Ts>
+    class soa_vector;
+
+    // Proxy for one row: reads and writes go to the element at the same
+    // index in every column.
+    template<class Owner, bool Const>
+    class soa_row {
+    public:
+        typedef typename Owner::value_type value_type;
+        typedef typename Owner::size_type size_type;
+
+        soa_row(Owner* owner, size_type index): _owner(owner), _index(index) {}
+
+        // A reference into column I; for a bool column, which is a packed
+        // ft::vector<bool>, its bit proxy or a plain bool.
+        template<size_t I>
+        typename std::conditional<Const,
+                typename ft::vector<typename std::tuple_element<I, value_type>::type>::const_reference,
+                typename ft::vector<typename std::tuple_element<I, value_type>::type>::reference>::type get() const {
+            return _owner->template column<I>()[_index];
+        }
+
+        operator value_type() const { return _owner->_row_value(_index); }
+
+        const soa_row& operator=( const value_type& value ) const {
+            _owner->_assign_row(_index, value);
+            return *this;
+        }
+
+        // Assigns the values of other, like an lvalue of value_type would.
+        const soa_row& operator=( const soa_row& other ) const {
+            _owner->_assign_row(_index, value_type(other));
+            return *this;
+        }
+
+        size_type index() const { return _index; }
+
+    private:
+        Owner* _owner;
+        size_type _index;
+    };
+
+    template<size_t I, class Owner, bool Const>
+    auto get(const soa_row<Owner, Const>& row) -> decltype(row.template get<I>()) {
+        return row.template get<I>();
+    }
+
+    // Random-access iterator over row indices; dereferencing yields a row
+    // proxy by value, as with std::vector<bool>.
+    template<class Owner, bool Const>
+    class soa_iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename Owner::value_type value_type;
+        typedef ptrdiff_t difference_type;
+        typedef soa_row<Owner, Const> reference;
+        typedef void pointer;
+
+        soa_iterator(): _owner(NULL), _index(0) {}
+        soa_iterator(Owner* owner, size_t index): _owner(owner), _index(index) {}
+
+        reference operator*() const { return reference(_owner, _index); }
+        reference operator[](difference_type n) const { return reference(_owner, _index + n); }
+
+        soa_iterator& operator++() { ++_index; return *this; }
+        soa_iterator operator++(int) { soa_iterator tmp(*this); ++_index; return tmp; }
+        soa_iterator& operator--() { --_index; return *this; }
+        soa_iterator operator--(int) { soa_iterator tmp(*this); --_index; return tmp; }
+        soa_iterator& operator+=(difference_type n) { _index += n; return *this; }
+        soa_iterator& operator-=(difference_type n) { _index -= n; return *this; }
+        soa_iterator operator+(difference_type n) const { return soa_iterator(_owner, _index + n); }
+        soa_iterator operator-(difference_type n) const { return soa_iterator(_owner, _index - n); }
+        difference_type operator-(const soa_iterator& other) const {
+            return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+        }
+
+        bool operator==(const soa_iterator& other) const { return _index == other._index; }
+        bool operator!=(const soa_iterator& other) const { return _index != other._index; }
+        bool operator<(const soa_iterator& other) const { return _index < other._index; }
+        bool operator>(const soa_iterator& other) const { return _index > other._index; }
+        bool operator<=(const soa_iterator& other) const { return _index <= other._index; }
+        bool operator>=(const soa_iterator& other) const { return _index >= other._index; }
+
+        size_t index() const { return _index; }
+
+    private:
+        Owner* _owner;
+        size_t _index;
+    };
+
+    // Structure of arrays: field I of every row lives in its own
+    // ft::vector, so a loop over one field streams only that field's bytes.
+    // Needs C++11.
+    template<class... Ts>
+    class soa_vector {
+    public:
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+        typedef std::tuple<Ts...> value_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef soa_row<soa_vector, false> reference;
+        typedef soa_row<const soa_vector, true> const_reference;
+        typedef soa_iterator<soa_vector, false> iterator;
+        typedef soa_iterator<const soa_vector, true> const_iterator;
+
+        static const size_t columns = sizeof...(Ts);
+
+        template<size_t I>
+        struct column_type { typedef typename std::tuple_element<I, value_type>::type type; };
+
+        soa_vector() {}
+        explicit soa_vector( size_type count, const value_type& value = value_type() ) {
+            resize(count, value);
+        }
+        soa_vector( const soa_vector& other ): _columns(other._columns) {}
+        soa_vector( soa_vector&& other ) noexcept: _columns(std::move(other._columns)) {}
+        ~soa_vector() {}
+
+        soa_vector& operator=( const soa_vector& other ) {
+            if (this != &other)
+                _columns = other._columns;
+            return *this;
+        }
+
+        soa_vector& operator=( soa_vector&& other ) noexcept {
+            if (this != &other)
+                _columns = std::move(other._columns);
+            return *this;
+        }
+
+        size_type size() const { return std::get<0>(_columns).size(); }
+        bool empty() const { return size() == 0; }
+        size_type capacity() const { return _capacity(_indices()); }
+
+        // Sum over the columns.
+        memory_footprint memory_usage() const { return _memory_usage(_indices()); }
+
+        template<size_t I>
+        ft::vector<typename column_type<I>::type>& column() { return std::get<I>(_columns); }
+        template<size_t I>
+        const ft::vector<typename column_type<I>::type>& column() const { return std::get<I>(_columns); }
+
+        // Not available for bool columns, whose bits are packed into words.
+        template<size_t I>
+        auto data() -> decltype(std::declval<ft::vector<typename column_type<I>::type>&>().data()) {
+            return std::get<I>(_columns).data();
+        }
+        template<size_t I>
+        auto data() const -> decltype(std::declval<const ft::vector<typename column_type<I>::type>&>().data()) {
+            return std::get<I>(_columns).data();
+        }
+
+        reference operator[]( size_type pos ) { return reference(this, pos); }
+        const_reference operator[]( size_type pos ) const { return const_reference(this, pos); }
+
+        reference at( size_type pos ) {
+            if (pos >= size())
+                throw std::out_of_range("Index out of range");
+            return reference(this, pos);
+        }
+        const_reference at( size_type pos ) const {
+            if (pos >= size())
+                throw std::out_of_range("Index out of range");
+            return const_reference(this, pos);
+        }
+
+        reference front() { return reference(this, 0); }
+        const_reference front() const { return const_reference(this, 0); }
+        reference back() { return reference(this, size() - 1); }
+        const_reference back() const { return const_reference(this, size() - 1); }
+
+        iterator begin() { return iterator(this, 0); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        iterator end() { return iterator(this, size()); }
+        const_iterator end() const { return const_iterator(this, size()); }
+
+        void reserve( size_type new_cap ) { _reserve(new_cap, _indices()); }
+        void shrink_to_fit() { _shrink_to_fit(_indices()); }
+
+        void resize( size_type count, const value_type& value = value_type() ) {
+            size_type old_size = size();
+            try {
+                _resize(count, value, _indices());
+            }
+            catch (...) {
+                _truncate(old_size, _indices());
+                throw;
+            }
+        }
+
+        void clear() { _truncate(0, _indices()); }
+
+        // A column that throws leaves every column at its old size.
+        void push_back( const value_type& value ) {
+            size_type old_size = size();
+            if (old_size == capacity())
+                reserve(old_size == 0 ? 1 : 2 * old_size);
+            try {
+                _push_back(value, _indices());
+            }
+            catch (...) {
+                _truncate(old_size, _indices());
+                throw;
+            }
+        }
+
+        // One argument per column.
+        template<class... Us>
+        void emplace_back( Us&&... fields ) {
+            static_assert(sizeof...(Us) == sizeof...(Ts), "emplace_back takes one value per column");
+            push_back(value_type(std::forward<Us>(fields)...));
+        }
+
+        void pop_back() { _pop_back(_indices()); }
+
+        iterator insert( iterator pos, const value_type& value ) {
+            size_type index = pos.index();
+            size_type done = 0;
+            try {
+                _insert(index, value, done, _indices());
+            }
+            catch (...) {
+                _undo_insert(index, done, _indices());
+                throw;
+            }
+            return iterator(this, index);
+        }
+
+        iterator erase( iterator pos ) {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase( iterator first, iterator last ) {
+            if (first < last)
+                _erase(first.index(), last.index(), _indices());
+            return iterator(this, first.index());
+        }
+
+        void swap( soa_vector& other ) {
+            _columns.swap(other._columns);
+        }
+
+        friend bool operator==( const soa_vector& lhs, const soa_vector& rhs ) { return lhs._columns == rhs._columns; }
+        friend bool operator!=( const soa_vector& lhs, const soa_vector& rhs ) { return !(lhs == rhs); }
+
+    private:
+        template<class Owner, bool Const> friend class soa_row;
+        typedef typename _make_index_sequence<sizeof...(Ts)>::type _indices;
+
+        std::tuple<ft::vector<Ts>...> _columns;
+
+        template<size_t... I>
+        value_type _row_value(size_type index, _index_sequence<I...>) const {
+            return value_type(std::get<I>(_columns)[index]...);
+        }
+        value_type _row_value(size_type index) const { return _row_value(index, _indices()); }
+
+        template<size_t... I>
+        void _assign_row(size_type index, const value_type& value, _index_sequence<I...>) {
+            int expand[] = { 0, (std::get<I>(_columns)[index] = std::get<I>(value), 0)... };
+            (void)expand;
+        }
+        void _assign_row(size_type index, const value_type& value) { _assign_row(index, value, _indices()); }
+
+        template<size_t... I>
+        size_type _capacity(_index_sequence<I...>) const {
+            size_type caps[] = { std::get<I>(_columns).capacity()... };
+            size_type cap = caps[0];
+            for (size_t i = 1; i < sizeof...(I); ++i)
+                if (caps[i] < cap)
+                    cap = caps[i];
+            return cap;
+        }
+
+        template<size_t... I>
+        memory_footprint _memory_usage(_index_sequence<I...>) const {
+            memory_footprint usage;
+            int expand[] = { 0, (usage += std::get<I>(_columns).memory_usage(), 0)... };
+            (void)expand;
+            return usage;
+        }
+
+        template<size_t... I>
+        void _reserve(size_type new_cap, _index_sequence<I...>) {
+            int expand[] = { 0, (std::get<I>(_columns).reserve(new_cap), 0)... };
+            (void)expand;
+        }
+
+        template<size_t... I>
+        void _shrink_to_fit(_index_sequence<I...>) {
+            int expand[] = { 0, (std::get<I>(_columns).shrink_to_fit(), 0)... };
+            (void)expand;
+        }
+
+        template<size_t... I>
+        void _resize(size_type count, const value_type& value, _index_sequence<I...>) {
+            int expand[] = { 0, (std::get<I>(_columns).resize(count, std::get<I>(value)), 0)... };
+            (void)expand;
+        }
+
+        // Drops every column back to count rows.
+        template<size_t... I>
+        void _truncate(size_type count, _index_sequence<I...>) {
+            int expand[] = { 0, (_truncate_column(std::get<I>(_columns), count), 0)... };
+            (void)expand;
+        }
+
+        template<class Column>
+        static void _truncate_column(Column& column, size_type count) {
+            if (column.size() > count)
+                column.erase(column.begin() + count, column.end());
+        }
+
+        template<size_t... I>
+        void _push_back(const value_type& value, _index_sequence<I...>) {
+            int expand[] = { 0, (std::get<I>(_columns).push_back(std::get<I>(value)), 0)... };
+            (void)expand;
+        }
+
+        template<size_t... I>
+        void _pop_back(_index_sequence<I...>) {
+            int expand[] = { 0, (std::get<I>(_columns).pop_back(), 0)... };
+            (void)expand;
+        }
+
+        template<size_t... I>
+        void _insert(size_type index, const value_type& value, size_type& done, _index_sequence<I...>) {
+            int expand[] = { 0, (std::get<I>(_columns).insert(std::get<I>(_columns).begin() + index, std::get<I>(value)), ++done, 0)... };
+            (void)expand;
+        }
+
+        // Removes the row inserted at index from the first done columns.
+        template<size_t... I>
+        void _undo_insert(size_type index, size_type done, _index_sequence<I...>) {
+            int expand[] = { 0, (I < done ? (std::get<I>(_columns).erase(std::get<I>(_columns).begin() + index), 0) : 0)... };
+            (void)expand;
+        }
+
+        template<size_t... I>
+        void _erase(size_type first, size_type last, _index_sequence<I...>) {
+            int expand[] = { 0, (std::get<I>(_columns).erase(std::get<I>(_columns).begin() + first,
+                                                             std::get<I>(_columns).begin() + last), 0)... };
+            (void)expand;
+        }
+    };
+
+    template<class... Ts>
+    const size_t soa_vector<Ts...>::columns;
+
+    template<class... Ts>
+    void swap( ft::soa_vector<Ts...>& lhs, ft::soa_vector<Ts...>& rhs ) { lhs.swap(rhs); }
+}
+
+# endif
+#endif//FT_CONTAINERS_SOA_VECTOR_HPP
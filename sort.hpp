@@ -0,0 +1,477 @@
+#ifndef FT_CONTAINERS_SORT_HPP
+# define FT_CONTAINERS_SORT_HPP
+# include <cstddef>
+# include <cstring>
+# include <algorithm>
+# include <functional>
+# include "iterator.hpp"
+# include "type_traits.hpp"
+# include "utility.hpp"
+# include "vector.hpp"
+
+namespace ft {
+    // Pattern-defeating quicksort: introsort with ninther pivots, a cheap
+    // path for runs of equal keys, a check for already partitioned input
+    // and a heapsort fallback after too many unbalanced partitions.
+    static const ptrdiff_t _sort_insertion_threshold = 24;
+    static const ptrdiff_t _sort_ninther_threshold = 128;
+    static const size_t _sort_partial_insertion_limit = 8;
+    static const size_t _sort_block_size = 64;
+    static const size_t _sort_radix_threshold = 256;
+
+    // Comparisons that compile to a flag instead of a branch, which lets the
+    // block partition below run without mispredictions.
+    template<class T, class Compare>
+    struct _sort_branchless: false_type {};
+    template<class T>
+    struct _sort_branchless<T, std::less<T> >: integral_constant<bool, is_arithmetic<T>::value> {};
+    template<class T>
+    struct _sort_branchless<T, std::greater<T> >: integral_constant<bool, is_arithmetic<T>::value> {};
+
+    // Contiguous ranges of integers in ascending order go to the radix sort.
+    template<class RandomIt, class Compare>
+    struct _sort_radix: false_type {};
+    template<class T>
+    struct _sort_radix<T*, std::less<T> >:
+        integral_constant<bool, is_integral<T>::value && !is_same<T, bool>::value> {};
+
+    template<class RandomIt, class Compare>
+    void _insertion_sort(RandomIt begin, RandomIt end, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type T;
+        if (begin == end)
+            return ;
+        for (RandomIt cur = begin + 1; cur != end; ++cur) {
+            RandomIt sift = cur;
+            RandomIt prev = cur - 1;
+            if (comp(*sift, *prev)) {
+                T tmp(FT_MOVE(*sift));
+                do {
+                    *sift-- = FT_MOVE(*prev);
+                } while (sift != begin && comp(tmp, *--prev));
+                *sift = FT_MOVE(tmp);
+            }
+        }
+    }
+
+    // Same, for ranges that have an element not greater than all of theirs
+    // right before begin, which stops the inner loop.
+    template<class RandomIt, class Compare>
+    void _unguarded_insertion_sort(RandomIt begin, RandomIt end, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type T;
+        if (begin == end)
+            return ;
+        for (RandomIt cur = begin + 1; cur != end; ++cur) {
+            RandomIt sift = cur;
+            RandomIt prev = cur - 1;
+            if (comp(*sift, *prev)) {
+                T tmp(FT_MOVE(*sift));
+                do {
+                    *sift-- = FT_MOVE(*prev);
+                } while (comp(tmp, *--prev));
+                *sift = FT_MOVE(tmp);
+            }
+        }
+    }
+
+    // Insertion sort that gives up once it has moved more than a few
+    // elements; returns whether the range ended up sorted.
+    template<class RandomIt, class Compare>
+    bool _partial_insertion_sort(RandomIt begin, RandomIt end, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type T;
+        if (begin == end)
+            return true;
+        size_t moved = 0;
+        for (RandomIt cur = begin + 1; cur != end; ++cur) {
+            RandomIt sift = cur;
+            RandomIt prev = cur - 1;
+            if (comp(*sift, *prev)) {
+                T tmp(FT_MOVE(*sift));
+                do {
+                    *sift-- = FT_MOVE(*prev);
+                } while (sift != begin && comp(tmp, *--prev));
+                *sift = FT_MOVE(tmp);
+                moved += cur - sift;
+            }
+            if (moved > _sort_partial_insertion_limit)
+                return false;
+        }
+        return true;
+    }
+
+    template<class RandomIt, class Compare>
+    void _sort2(RandomIt a, RandomIt b, Compare comp) {
+        if (comp(*b, *a))
+            std::iter_swap(a, b);
+    }
+
+    template<class RandomIt, class Compare>
+    void _sort3(RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+        _sort2(a, b, comp);
+        _sort2(b, c, comp);
+        _sort2(a, b, comp);
+    }
+
+    // Swaps the elements at first + offsets_l[i] with those at
+    // last - offsets_r[i]. Unless both blocks have the same count, a cyclic
+    // permutation does it with one move per element instead of three.
+    template<class RandomIt>
+    void _swap_offsets(RandomIt first, RandomIt last, const unsigned char* offsets_l,
+                       const unsigned char* offsets_r, size_t num, bool use_swaps) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type T;
+        if (use_swaps) {
+            for (size_t i = 0; i < num; ++i)
+                std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+        else if (num > 0) {
+            RandomIt l = first + offsets_l[0];
+            RandomIt r = last - offsets_r[0];
+            T tmp(FT_MOVE(*l));
+            *l = FT_MOVE(*r);
+            for (size_t i = 1; i < num; ++i) {
+                l = first + offsets_l[i];
+                *r = FT_MOVE(*l);
+                r = last - offsets_r[i];
+                *l = FT_MOVE(*r);
+            }
+            *r = FT_MOVE(tmp);
+        }
+    }
+
+    // Partitions around *begin into [< pivot] pivot [>= pivot] and returns
+    // the pivot position and whether no element had to move.
+    template<class RandomIt, class Compare>
+    ft::pair<RandomIt, bool> _partition_right(RandomIt begin, RandomIt end, Compare comp, false_type) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type T;
+        T pivot(FT_MOVE(*begin));
+        RandomIt first = begin;
+        RandomIt last = end;
+        while (comp(*++first, pivot))
+            ;
+        if (first - 1 == begin)
+            while (first < last && !comp(*--last, pivot))
+                ;
+        else
+            while (!comp(*--last, pivot))
+                ;
+        bool already_partitioned = first >= last;
+        while (first < last) {
+            std::iter_swap(first, last);
+            while (comp(*++first, pivot))
+                ;
+            while (!comp(*--last, pivot))
+                ;
+        }
+        RandomIt pivot_pos = first - 1;
+        *begin = FT_MOVE(*pivot_pos);
+        *pivot_pos = FT_MOVE(pivot);
+        return ft::make_pair(pivot_pos, already_partitioned);
+    }
+
+    // Block partition after Edelkamp and Weiss: the comparisons of a block
+    // only record offsets of misplaced elements, then those are swapped in
+    // bulk, so no branch depends on the outcome of a comparison.
+    template<class RandomIt, class Compare>
+    ft::pair<RandomIt, bool> _partition_right(RandomIt begin, RandomIt end, Compare comp, true_type) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type T;
+        T pivot(FT_MOVE(*begin));
+        RandomIt first = begin;
+        RandomIt last = end;
+        while (comp(*++first, pivot))
+            ;
+        if (first - 1 == begin)
+            while (first < last && !comp(*--last, pivot))
+                ;
+        else
+            while (!comp(*--last, pivot))
+                ;
+        bool already_partitioned = first >= last;
+        if (!already_partitioned) {
+            std::iter_swap(first, last);
+            ++first;
+            unsigned char offsets_l_block[_sort_block_size];
+            unsigned char offsets_r_block[_sort_block_size];
+            unsigned char* offsets_l = offsets_l_block;
+            unsigned char* offsets_r = offsets_r_block;
+            RandomIt base_l = first;
+            RandomIt base_r = last;
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+            while (first < last) {
+                size_t unknown = last - first;
+                size_t split_l = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+                size_t split_r = num_r == 0 ? unknown - split_l : 0;
+                if (split_l > _sort_block_size)
+                    split_l = _sort_block_size;
+                if (split_r > _sort_block_size)
+                    split_r = _sort_block_size;
+                for (size_t i = 0; i < split_l; ++first) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i++);
+                    num_l += !comp(*first, pivot);
+                }
+                for (size_t i = 0; i < split_r; ) {
+                    offsets_r[num_r] = static_cast<unsigned char>(++i);
+                    num_r += comp(*--last, pivot);
+                }
+                size_t num = std::min(num_l, num_r);
+                _swap_offsets(base_l, base_r, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+                if (num_l == 0) {
+                    start_l = 0;
+                    base_l = first;
+                }
+                if (num_r == 0) {
+                    start_r = 0;
+                    base_r = last;
+                }
+            }
+            if (num_l) {
+                offsets_l += start_l;
+                while (num_l--)
+                    std::iter_swap(base_l + offsets_l[num_l], --last);
+                first = last;
+            }
+            if (num_r) {
+                offsets_r += start_r;
+                while (num_r--)
+                    std::iter_swap(base_r - offsets_r[num_r], first), ++first;
+                last = first;
+            }
+        }
+        RandomIt pivot_pos = first - 1;
+        *begin = FT_MOVE(*pivot_pos);
+        *pivot_pos = FT_MOVE(pivot);
+        return ft::make_pair(pivot_pos, already_partitioned);
+    }
+
+    // Partitions into [<= pivot] pivot [> pivot]. Used when the pivot equals
+    // the element before the range, so everything equal to it is done.
+    template<class RandomIt, class Compare>
+    RandomIt _partition_left(RandomIt begin, RandomIt end, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type T;
+        T pivot(FT_MOVE(*begin));
+        RandomIt first = begin;
+        RandomIt last = end;
+        while (comp(pivot, *--last))
+            ;
+        if (last + 1 == end)
+            while (first < last && !comp(pivot, *++first))
+                ;
+        else
+            while (!comp(pivot, *++first))
+                ;
+        while (first < last) {
+            std::iter_swap(first, last);
+            while (comp(pivot, *--last))
+                ;
+            while (!comp(pivot, *++first))
+                ;
+        }
+        RandomIt pivot_pos = last;
+        *begin = FT_MOVE(*pivot_pos);
+        *pivot_pos = FT_MOVE(pivot);
+        return pivot_pos;
+    }
+
+    template<class RandomIt, class Compare, class Branchless>
+    void _pdqsort_loop(RandomIt begin, RandomIt end, Compare comp, int bad_allowed, bool leftmost, Branchless branchless) {
+        typedef typename ft::iterator_traits<RandomIt>::difference_type diff_t;
+        for (;;) {
+            diff_t size = end - begin;
+            if (size < _sort_insertion_threshold) {
+                if (leftmost)
+                    _insertion_sort(begin, end, comp);
+                else
+                    _unguarded_insertion_sort(begin, end, comp);
+                return ;
+            }
+            diff_t s2 = size / 2;
+            if (size > _sort_ninther_threshold) {
+                _sort3(begin, begin + s2, end - 1, comp);
+                _sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+                _sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+                _sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+                std::iter_swap(begin, begin + s2);
+            }
+            else
+                _sort3(begin + s2, begin, end - 1, comp);
+
+            if (!leftmost && !comp(*(begin - 1), *begin)) {
+                begin = _partition_left(begin, end, comp) + 1;
+                continue;
+            }
+
+            ft::pair<RandomIt, bool> part = _partition_right(begin, end, comp, branchless);
+            RandomIt pivot_pos = part.first;
+            diff_t l_size = pivot_pos - begin;
+            diff_t r_size = end - (pivot_pos + 1);
+
+            if (l_size < size / 8 || r_size < size / 8) {
+                if (--bad_allowed == 0) {
+                    std::make_heap(begin, end, comp);
+                    std::sort_heap(begin, end, comp);
+                    return ;
+                }
+                // Break up patterns that keep producing bad pivots.
+                if (l_size >= _sort_insertion_threshold) {
+                    std::iter_swap(begin, begin + l_size / 4);
+                    std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                    if (l_size > _sort_ninther_threshold) {
+                        std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                        std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                        std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                        std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                    }
+                }
+                if (r_size >= _sort_insertion_threshold) {
+                    std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                    std::iter_swap(end - 1, end - r_size / 4);
+                    if (r_size > _sort_ninther_threshold) {
+                        std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                        std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                        std::iter_swap(end - 2, end - (1 + r_size / 4));
+                        std::iter_swap(end - 3, end - (2 + r_size / 4));
+                    }
+                }
+            }
+            else if (part.second && _partial_insertion_sort(begin, pivot_pos, comp)
+                     && _partial_insertion_sort(pivot_pos + 1, end, comp))
+                return ;
+
+            _pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost, branchless);
+            begin = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+
+    template<class RandomIt, class Compare>
+    void _pdqsort(RandomIt begin, RandomIt end, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type T;
+        if (begin == end)
+            return ;
+        int log2 = 0;
+        for (size_t n = end - begin; n > 1; n >>= 1)
+            ++log2;
+        _pdqsort_loop(begin, end, comp, log2, true,
+                      integral_constant<bool, _sort_branchless<T, Compare>::value>());
+    }
+
+    // LSD radix sort on bytes, with the sign bit flipped so signed keys order
+    // correctly. All histograms come from one pass, and a byte position on
+    // which every key agrees is skipped. Stable.
+    template<class T>
+    void _radix_sort(T* first, T* last) {
+        size_t n = last - first;
+        const size_t passes = sizeof(T);
+        const unsigned long long sign = T(-1) < T(0) ? 1ULL << (sizeof(T) * 8 - 1) : 0;
+        size_t counts[sizeof(T)][256];
+        std::memset(counts, 0, sizeof(counts));
+        for (T* p = first; p != last; ++p) {
+            unsigned long long key = static_cast<unsigned long long>(*p) ^ sign;
+            for (size_t b = 0; b < passes; ++b)
+                ++counts[b][(key >> (8 * b)) & 0xFF];
+        }
+        ft::vector<T> buffer;
+        buffer.resize_uninitialized(n);
+        T* src = first;
+        T* dst = buffer.data();
+        for (size_t b = 0; b < passes; ++b) {
+            unsigned long long head = static_cast<unsigned long long>(*first) ^ sign;
+            if (counts[b][(head >> (8 * b)) & 0xFF] == n)
+                continue;
+            size_t offsets[256];
+            size_t sum = 0;
+            for (size_t i = 0; i < 256; ++i) {
+                offsets[i] = sum;
+                sum += counts[b][i];
+            }
+            for (T* p = src; p != src + n; ++p) {
+                unsigned long long key = static_cast<unsigned long long>(*p) ^ sign;
+                dst[offsets[(key >> (8 * b)) & 0xFF]++] = *p;
+            }
+            std::swap(src, dst);
+        }
+        if (src != first)
+            std::memcpy(first, src, n * sizeof(T));
+    }
+
+    template<class RandomIt, class Compare>
+    void _sort(RandomIt first, RandomIt last, Compare comp, false_type) {
+        _pdqsort(first, last, comp);
+    }
+
+    template<class RandomIt, class Compare>
+    void _sort(RandomIt first, RandomIt last, Compare comp, true_type) {
+        if (static_cast<size_t>(last - first) < _sort_radix_threshold)
+            _pdqsort(first, last, comp);
+        else
+            _radix_sort(first, last);
+    }
+
+    template<class RandomIt, class Compare>
+    void sort(RandomIt first, RandomIt last, Compare comp) {
+        _sort(first, last, comp, integral_constant<bool, _sort_radix<RandomIt, Compare>::value>());
+    }
+
+    template<class RandomIt>
+    void sort(RandomIt first, RandomIt last) {
+        ft::sort(first, last, std::less<typename ft::iterator_traits<RandomIt>::value_type>());
+    }
+
+    // Top-down merge sort over insertion-sorted runs; the left half of each
+    // merge is moved to buffer, which needs room for half the range.
+    template<class RandomIt, class Compare, class Buffer>
+    void _merge_sort(RandomIt first, RandomIt last, Compare comp, Buffer& buffer) {
+        if (last - first <= 2 * _sort_insertion_threshold) {
+            _insertion_sort(first, last, comp);
+            return ;
+        }
+        RandomIt mid = first + (last - first) / 2;
+        _merge_sort(first, mid, comp, buffer);
+        _merge_sort(mid, last, comp, buffer);
+        if (!comp(*mid, *(mid - 1)))
+            return ;
+        buffer.clear();
+        for (RandomIt it = first; it != mid; ++it)
+            buffer.push_back(FT_MOVE(*it));
+        typename Buffer::iterator left = buffer.begin();
+        RandomIt right = mid;
+        RandomIt out = first;
+        while (left != buffer.end() && right != last) {
+            if (comp(*right, *left))
+                *out++ = FT_MOVE(*right++);
+            else
+                *out++ = FT_MOVE(*left++);
+        }
+        for (; left != buffer.end(); ++left, ++out)
+            *out = FT_MOVE(*left);
+    }
+
+    template<class RandomIt, class Compare>
+    void _stable_sort(RandomIt first, RandomIt last, Compare comp, false_type) {
+        ft::vector<typename ft::iterator_traits<RandomIt>::value_type> buffer;
+        buffer.reserve((last - first) / 2 + 1);
+        _merge_sort(first, last, comp, buffer);
+    }
+
+    template<class RandomIt, class Compare>
+    void _stable_sort(RandomIt first, RandomIt last, Compare comp, true_type) {
+        if (static_cast<size_t>(last - first) < _sort_radix_threshold)
+            _stable_sort(first, last, comp, false_type());
+        else
+            _radix_sort(first, last);
+    }
+
+    template<class RandomIt, class Compare>
+    void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+        _stable_sort(first, last, comp, integral_constant<bool, _sort_radix<RandomIt, Compare>::value>());
+    }
+
+    template<class RandomIt>
+    void stable_sort(RandomIt first, RandomIt last) {
+        ft::stable_sort(first, last, std::less<typename ft::iterator_traits<RandomIt>::value_type>());
+    }
+}
+
+#endif//FT_CONTAINERS_SORT_HPP
@@ -0,0 +1,191 @@
+#ifndef FT_CONTAINERS_SPSC_RING_HPP
+# define FT_CONTAINERS_SPSC_RING_HPP
+# include <memory>
+# include <cstddef>
+# include <stdexcept>
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+namespace ft {
+    // Bounded ring buffer for exactly one producer and one consumer thread.
+    // Each side owns its index and keeps a cached copy of the other one, so
+    // it only reads the other side's cache line when the ring looks full or
+    // empty. push_n and pop_n move a whole batch and publish it with a single
+    // store.
+    template< class T, class Alloc = std::allocator<T> >
+    class spsc_ring {
+    public:
+        typedef T value_type;
+        typedef Alloc allocator_type;
+        typedef size_t size_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+
+        // The capacity is rounded up to a power of two.
+        explicit spsc_ring( size_type capacity, const allocator_type& alloc = allocator_type() ):
+            _buffer(NULL), _mask(0), _head(0), _tail_cache(0), _tail(0), _head_cache(0), _allocator(alloc) {
+            if (capacity == 0)
+                throw std::invalid_argument("spsc_ring: capacity must not be zero");
+            size_type size = 1;
+            while (size < capacity)
+                size <<= 1;
+            _buffer = _allocator.allocate(size);
+            _mask = size - 1;
+        }
+
+        ~spsc_ring() {
+            for ( ; _head != _tail ; ++_head)
+                _allocator.destroy(_buffer + (_head & _mask));
+            _allocator.deallocate(_buffer, _mask + 1);
+        }
+
+        size_type capacity() const { return _mask + 1; }
+
+        // Exact from either side's own thread while the other is idle, a
+        // snapshot otherwise.
+        size_type size() const {
+            return __atomic_load_n(&_tail, __ATOMIC_ACQUIRE) - __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+        }
+        bool empty() const { return size() == 0; }
+
+        // Producer side.
+
+        bool try_push( const T& value ) {
+            size_type tail = _tail;
+            if (_free(tail, 1) == 0)
+                return false;
+            _allocator.construct(_buffer + (tail & _mask), value);
+            __atomic_store_n(&_tail, tail + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+# if FT_CONTAINERS_CXX11
+        bool try_push( T&& value ) {
+            return try_emplace(std::move(value));
+        }
+
+        template< class... Args >
+        bool try_emplace( Args&&... args ) {
+            size_type tail = _tail;
+            if (_free(tail, 1) == 0)
+                return false;
+            _allocator.construct(_buffer + (tail & _mask), std::forward<Args>(args)...);
+            __atomic_store_n(&_tail, tail + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+# endif
+
+        // Pushes up to count elements from first and returns how many fit.
+        // Elements constructed before an exception are still published.
+        template< class InputIt >
+        size_type push_n( InputIt first, size_type count ) {
+            size_type tail = _tail;
+            size_type n = _free(tail, count);
+            size_type i = 0;
+            try {
+                for ( ; i < n ; ++i, ++first)
+                    _allocator.construct(_buffer + ((tail + i) & _mask), *first);
+            }
+            catch (...) {
+                __atomic_store_n(&_tail, tail + i, __ATOMIC_RELEASE);
+                throw;
+            }
+            __atomic_store_n(&_tail, tail + n, __ATOMIC_RELEASE);
+            return n;
+        }
+
+        void push( const T& value ) {
+            spin_backoff backoff;
+            while (!try_push(value))
+                backoff.pause();
+        }
+
+        // Consumer side.
+
+        // The oldest element, or NULL when the ring is empty. It stays valid
+        // until the consumer pops it.
+        T* front() {
+            size_type head = _head;
+            if (_available(head, 1) == 0)
+                return NULL;
+            return _buffer + (head & _mask);
+        }
+
+        bool try_pop( T& out ) {
+            size_type head = _head;
+            if (_available(head, 1) == 0)
+                return false;
+            T* p = _buffer + (head & _mask);
+            out = FT_MOVE(*p);
+            _allocator.destroy(p);
+            __atomic_store_n(&_head, head + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        // Pops up to count elements into out and returns how many there were.
+        template< class OutputIt >
+        size_type pop_n( OutputIt out, size_type count ) {
+            size_type head = _head;
+            size_type n = _available(head, count);
+            size_type i = 0;
+            try {
+                for ( ; i < n ; ++i, ++out) {
+                    T* p = _buffer + ((head + i) & _mask);
+                    *out = FT_MOVE(*p);
+                    _allocator.destroy(p);
+                }
+            }
+            catch (...) {
+                __atomic_store_n(&_head, head + i, __ATOMIC_RELEASE);
+                throw;
+            }
+            __atomic_store_n(&_head, head + n, __ATOMIC_RELEASE);
+            return n;
+        }
+
+        void pop( T& out ) {
+            spin_backoff backoff;
+            while (!try_pop(out))
+                backoff.pause();
+        }
+
+    private:
+        // Read-only after construction, then one line per side: the consumer
+        // writes _head and _tail_cache, the producer _tail and _head_cache.
+        T* _buffer;
+        size_type _mask;
+        char _pad0[cache_line_size - sizeof(T*) - sizeof(size_type)];
+        size_type _head;
+        size_type _tail_cache;
+        char _pad1[cache_line_size - 2 * sizeof(size_type)];
+        size_type _tail;
+        size_type _head_cache;
+        char _pad2[cache_line_size - 2 * sizeof(size_type)];
+        allocator_type _allocator;
+
+        spsc_ring( const spsc_ring& );
+        spsc_ring& operator=( const spsc_ring& );
+
+        // Room for up to wanted elements at tail, rereading the consumer's
+        // index only when the cached one says there is not enough.
+        size_type _free( size_type tail, size_type wanted ) {
+            size_type room = capacity() - (tail - _head_cache);
+            if (room < wanted) {
+                _head_cache = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+                room = capacity() - (tail - _head_cache);
+            }
+            return room < wanted ? room : wanted;
+        }
+
+        size_type _available( size_type head, size_type wanted ) {
+            size_type ready = _tail_cache - head;
+            if (ready < wanted) {
+                _tail_cache = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+                ready = _tail_cache - head;
+            }
+            return ready < wanted ? ready : wanted;
+        }
+    };
+}
+
+#endif//FT_CONTAINERS_SPSC_RING_HPP
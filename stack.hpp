@@ -1,10 +1,11 @@
 #ifndef FT_CONTAINERS_STACK_HPP
 # define FT_CONTAINERS_STACK_HPP
-# include <vector>
 # include <cstddef>
+# include "deque.hpp"
+# include "small_vector.hpp"
 
 namespace ft {
-template <class T, class Container = std::vector<T> >
+template <class T, class Container = ft::deque<T> >
 class stack {
 public:
     typedef T value_type;
@@ -22,6 +23,7 @@ public:
     value_type& top() { return c.back(); } ;
     const value_type& top() const { return c.back(); };
     size_type size() const { return c.size(); }
+    memory_footprint memory_usage() const { return c.memory_usage(); }
     void push( const value_type& value ) { c.push_back(value); }
     void pop() { c.pop_back(); }
     bool empty() const { return c.empty(); }
@@ -38,6 +40,50 @@ public:
 
     friend bool operator>= (const ft::stack<T,Container>& lhs, const ft::stack<T,Container>& rhs) { return lhs.c >= rhs.c; }
 
+protected:
+    container_type c;
+};
+
+// Stack whose first N elements are stored inside the object, for the common
+// case of shallow stacks that should never touch the allocator.
+template <class T, size_t N, class Alloc>
+class stack<T, ft::small_vector<T, N, Alloc> > {
+public:
+    typedef T value_type;
+    typedef ft::small_vector<T, N, Alloc> container_type;
+    typedef size_t size_type;
+
+    explicit stack( const container_type& ctnr = container_type() ): c(ctnr) {}
+    stack( const stack& other ): c(other.c) {}
+    ~stack() {}
+    stack& operator=( const stack& other ) {
+        if (this != &other)
+            c = other.c;
+        return *this;
+    }
+    value_type& top() { return c.back(); }
+    const value_type& top() const { return c.back(); }
+    size_type size() const { return c.size(); }
+    memory_footprint memory_usage() const { return c.memory_usage(); }
+    size_type capacity() const { return c.capacity(); }
+    bool is_inline() const { return c.is_inline(); }
+    void reserve( size_type new_cap ) { c.reserve(new_cap); }
+    void push( const value_type& value ) { c.push_back(value); }
+    void pop() { c.pop_back(); }
+    bool empty() const { return c.empty(); }
+
+    friend bool operator== (const stack& lhs, const stack& rhs) { return lhs.c == rhs.c; }
+
+    friend bool operator!= (const stack& lhs, const stack& rhs) { return lhs.c != rhs.c; }
+
+    friend bool operator<  (const stack& lhs, const stack& rhs) { return lhs.c < rhs.c; }
+
+    friend bool operator<= (const stack& lhs, const stack& rhs) { return lhs.c <= rhs.c; }
+
+    friend bool operator>  (const stack& lhs, const stack& rhs) { return lhs.c > rhs.c; }
+
+    friend bool operator>= (const stack& lhs, const stack& rhs) { return lhs.c >= rhs.c; }
+
 protected:
     container_type c;
 };
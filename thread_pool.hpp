@@ -0,0 +1,305 @@
+#ifndef FT_CONTAINERS_THREAD_POOL_HPP
+# define FT_CONTAINERS_THREAD_POOL_HPP
+# include <cstddef>
+# include <new>
+# include <stdexcept>
+# include <pthread.h>
+# include <unistd.h>
+# include <time.h>
+# include <sys/time.h>
+# include <exception>
+# include "type_traits.hpp"
+# include "deque.hpp"
+# include "vector.hpp"
+
+namespace ft {
+    // Fixed set of worker threads, each owning a deque of tasks. A worker
+    // pops from the back of its own deque and, when that is empty, steals
+    // from the front of the others, so nested work stays local while idle
+    // threads pick up what is left.
+    class thread_pool {
+    public:
+        typedef void (*function_type)(void*);
+
+        // threads == 0 starts one worker per online CPU.
+        explicit thread_pool(size_t threads = 0): _queued(0), _next(0), _stop(false) {
+            if (threads == 0) {
+                long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+                threads = cpus > 0 ? static_cast<size_t>(cpus) : 1;
+            }
+            pthread_mutex_init(&_sleep_lock, NULL);
+            pthread_cond_init(&_wake, NULL);
+            _workers.reserve(threads);
+            for (size_t i = 0; i < threads; ++i) {
+                worker* w = new worker(this, i);
+                _workers.push_back(w);
+            }
+            for (size_t i = 0; i < threads; ++i)
+                if (pthread_create(&_workers[i]->thread, NULL, &thread_pool::_main, _workers[i]) != 0) {
+                    _shutdown(i);
+                    throw std::runtime_error("thread_pool: cannot start worker thread");
+                }
+        }
+
+        ~thread_pool() {
+            _shutdown(_workers.size());
+        }
+
+        size_t size() const { return _workers.size(); }
+
+        // Queues fn(arg). From a worker of this pool the task goes to that
+        // worker's own deque; from any other thread they are spread round robin.
+        void submit(function_type fn, void* arg) {
+            task t;
+            t.fn = fn;
+            t.arg = arg;
+            worker* self = _current();
+            worker* w = self != NULL && self->pool == this ? self
+                    : _workers[__atomic_fetch_add(&_next, 1, __ATOMIC_RELAXED) % _workers.size()];
+            pthread_mutex_lock(&w->lock);
+            w->tasks.push_back(t);
+            pthread_mutex_unlock(&w->lock);
+            __atomic_add_fetch(&_queued, 1, __ATOMIC_SEQ_CST);
+            pthread_mutex_lock(&_sleep_lock);
+            pthread_cond_signal(&_wake);
+            pthread_mutex_unlock(&_sleep_lock);
+        }
+
+        // Runs one queued task on the calling thread, if there is any; used
+        // by waiting threads so they help instead of blocking.
+        bool run_pending() {
+            task t;
+            worker* self = _current();
+            if (!_take(self != NULL && self->pool == this ? self : NULL, t))
+                return false;
+            t.fn(t.arg);
+            return true;
+        }
+
+        // Process-wide pool used by the parallel algorithms.
+        static thread_pool& instance() {
+            static thread_pool pool;
+            return pool;
+        }
+
+    private:
+        struct task {
+            function_type fn;
+            void* arg;
+        };
+
+        struct worker {
+            worker(thread_pool* p, size_t i): pool(p), index(i) { pthread_mutex_init(&lock, NULL); }
+            ~worker() { pthread_mutex_destroy(&lock); }
+
+            thread_pool* pool;
+            size_t index;
+            pthread_t thread;
+            pthread_mutex_t lock;
+            ft::deque<task> tasks;
+        };
+
+        ft::vector<worker*> _workers;
+        pthread_mutex_t _sleep_lock;
+        pthread_cond_t _wake;
+        size_t _queued;
+        size_t _next;
+        bool _stop;
+
+        thread_pool(const thread_pool&);
+        thread_pool& operator=(const thread_pool&);
+
+        static worker*& _current() {
+            static __thread worker* current = NULL;
+            return current;
+        }
+
+        // Own deque first, newest task first; then the oldest task of the
+        // other workers, starting after self so thieves spread out.
+        bool _take(worker* self, task& t) {
+            if (__atomic_load_n(&_queued, __ATOMIC_SEQ_CST) == 0)
+                return false;
+            if (self != NULL) {
+                pthread_mutex_lock(&self->lock);
+                bool found = !self->tasks.empty();
+                if (found) {
+                    t = self->tasks.back();
+                    self->tasks.pop_back();
+                }
+                pthread_mutex_unlock(&self->lock);
+                if (found) {
+                    __atomic_sub_fetch(&_queued, 1, __ATOMIC_SEQ_CST);
+                    return true;
+                }
+            }
+            size_t n = _workers.size();
+            size_t start = self != NULL ? self->index + 1 : 0;
+            for (size_t i = 0; i < n; ++i) {
+                worker* victim = _workers[(start + i) % n];
+                if (victim == self)
+                    continue;
+                pthread_mutex_lock(&victim->lock);
+                bool found = !victim->tasks.empty();
+                if (found) {
+                    t = victim->tasks.front();
+                    victim->tasks.pop_front();
+                }
+                pthread_mutex_unlock(&victim->lock);
+                if (found) {
+                    __atomic_sub_fetch(&_queued, 1, __ATOMIC_SEQ_CST);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void* _main(void* arg) {
+            worker* self = static_cast<worker*>(arg);
+            thread_pool* pool = self->pool;
+            _current() = self;
+            for (;;) {
+                task t;
+                if (pool->_take(self, t)) {
+                    t.fn(t.arg);
+                    continue;
+                }
+                pthread_mutex_lock(&pool->_sleep_lock);
+                while (!pool->_stop && __atomic_load_n(&pool->_queued, __ATOMIC_SEQ_CST) == 0)
+                    pthread_cond_wait(&pool->_wake, &pool->_sleep_lock);
+                bool done = pool->_stop && __atomic_load_n(&pool->_queued, __ATOMIC_SEQ_CST) == 0;
+                pthread_mutex_unlock(&pool->_sleep_lock);
+                if (done)
+                    return NULL;
+            }
+        }
+
+        // Lets the first started workers drain their queues and exit.
+        void _shutdown(size_t started) {
+            pthread_mutex_lock(&_sleep_lock);
+            _stop = true;
+            pthread_cond_broadcast(&_wake);
+            pthread_mutex_unlock(&_sleep_lock);
+            for (size_t i = 0; i < started; ++i)
+                pthread_join(_workers[i]->thread, NULL);
+            for (size_t i = 0; i < _workers.size(); ++i)
+                delete _workers[i];
+            _workers.clear();
+            pthread_cond_destroy(&_wake);
+            pthread_mutex_destroy(&_sleep_lock);
+        }
+    };
+
+    // Tasks submitted through a group can be waited for together. The
+    // waiting thread runs queued tasks meanwhile, so a task may itself
+    // start and wait for a nested group without tying up a worker.
+    class task_group {
+    public:
+        typedef thread_pool::function_type function_type;
+
+        explicit task_group(thread_pool& pool = thread_pool::instance()):
+            _pool(pool), _pending(0), _failed(false) {
+            pthread_mutex_init(&_lock, NULL);
+            pthread_cond_init(&_done, NULL);
+        }
+
+        ~task_group() {
+            try {
+                wait();
+            }
+            catch (...) {}
+            pthread_cond_destroy(&_done);
+            pthread_mutex_destroy(&_lock);
+        }
+
+        thread_pool& pool() const { return _pool; }
+
+        void run(function_type fn, void* arg) {
+            job* j = new job(this, fn, arg);
+            __atomic_add_fetch(&_pending, 1, __ATOMIC_SEQ_CST);
+            _pool.submit(&task_group::_execute, j);
+        }
+
+        // Returns once every task has finished. If one of them threw, the
+        // exception is rethrown here (in C++98 as std::runtime_error).
+        void wait() {
+            while (__atomic_load_n(&_pending, __ATOMIC_SEQ_CST) != 0) {
+                if (_pool.run_pending())
+                    continue;
+                pthread_mutex_lock(&_lock);
+                if (__atomic_load_n(&_pending, __ATOMIC_SEQ_CST) != 0) {
+                    struct timeval now;
+                    gettimeofday(&now, NULL);
+                    struct timespec until;
+                    until.tv_sec = now.tv_sec;
+                    until.tv_nsec = (now.tv_usec + 200) * 1000L;
+                    if (until.tv_nsec >= 1000000000L) {
+                        until.tv_sec += 1;
+                        until.tv_nsec -= 1000000000L;
+                    }
+                    pthread_cond_timedwait(&_done, &_lock, &until);
+                }
+                pthread_mutex_unlock(&_lock);
+            }
+            // The last task decrements and signals under the lock; taking it
+            // once more ensures that task is done with this group.
+            pthread_mutex_lock(&_lock);
+            bool failed = _failed;
+            _failed = false;
+            pthread_mutex_unlock(&_lock);
+            if (!failed)
+                return ;
+# if FT_CONTAINERS_CXX11
+            std::exception_ptr error = _error;
+            _error = std::exception_ptr();
+            std::rethrow_exception(error);
+# else
+            throw std::runtime_error("task_group: a task threw an exception");
+# endif
+        }
+
+    private:
+        struct job {
+            job(task_group* g, function_type f, void* a): group(g), fn(f), arg(a) {}
+            task_group* group;
+            function_type fn;
+            void* arg;
+        };
+
+        thread_pool& _pool;
+        size_t _pending;
+        bool _failed;
+# if FT_CONTAINERS_CXX11
+        std::exception_ptr _error;
+# endif
+        pthread_mutex_t _lock;
+        pthread_cond_t _done;
+
+        task_group(const task_group&);
+        task_group& operator=(const task_group&);
+
+        static void _execute(void* arg) {
+            job* j = static_cast<job*>(arg);
+            task_group* g = j->group;
+            try {
+                j->fn(j->arg);
+            }
+            catch (...) {
+                pthread_mutex_lock(&g->_lock);
+                if (!g->_failed) {
+                    g->_failed = true;
+# if FT_CONTAINERS_CXX11
+                    g->_error = std::current_exception();
+# endif
+                }
+                pthread_mutex_unlock(&g->_lock);
+            }
+            delete j;
+            pthread_mutex_lock(&g->_lock);
+            if (__atomic_sub_fetch(&g->_pending, 1, __ATOMIC_SEQ_CST) == 0)
+                pthread_cond_broadcast(&g->_done);
+            pthread_mutex_unlock(&g->_lock);
+        }
+    };
+}
+
+#endif//FT_CONTAINERS_THREAD_POOL_HPP
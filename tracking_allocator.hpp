@@ -0,0 +1,204 @@
+#ifndef FT_CONTAINERS_TRACKING_ALLOCATOR_HPP
+# define FT_CONTAINERS_TRACKING_ALLOCATOR_HPP
+# include <cstddef>
+# include <climits>
+# include <memory>
+# include <ostream>
+# include <pthread.h>
+# include "type_traits.hpp"
+# include "memory.hpp"
+
+// "file.cpp:123", a tag naming the line it appears on.
+# define FT_ALLOC_SITE FT_ALLOC_SITE_AT(__FILE__, __LINE__)
+# define FT_ALLOC_SITE_AT(file, line) FT_ALLOC_SITE_STRING(file, line)
+# define FT_ALLOC_SITE_STRING(file, line) file ":" #line
+
+namespace ft {
+    // Counters fed by tracking_allocator. Updates are atomic, so allocators
+    // in different threads can share one object. Every alloc_stats alive is
+    // listed, so print_all() can report them all, e.g. one per call site:
+    //
+    //     static ft::alloc_stats stats(FT_ALLOC_SITE);
+    //     ft::map<K, V, std::less<K>, ft::tracking_allocator<ft::pair<const K, V> > > m(std::less<K>(), &stats);
+    class alloc_stats {
+    public:
+        // Bucket b counts allocations of [2^b, 2^(b+1)) bytes; bucket 0
+        // also takes empty ones.
+        static const size_t histogram_buckets = sizeof(size_t) * CHAR_BIT;
+
+        explicit alloc_stats(const char* tag = "untagged"): _tag(tag), _prev(NULL), _next(NULL) {
+            reset();
+            _link();
+        }
+
+        ~alloc_stats() { _unlink(); }
+
+        const char* tag() const { return _tag; }
+        size_t live_bytes() const { return _load(_live_bytes); }
+        size_t peak_bytes() const { return _load(_peak_bytes); }
+        size_t total_bytes() const { return _load(_total_bytes); }
+        size_t allocations() const { return _load(_allocations); }
+        size_t deallocations() const { return _load(_deallocations); }
+        size_t live_allocations() const { return allocations() - deallocations(); }
+        size_t histogram(size_t bucket) const { return _load(_histogram[bucket]); }
+
+        void record_allocation(size_t bytes) {
+            size_t live = __atomic_add_fetch(&_live_bytes, bytes, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&_total_bytes, bytes, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&_allocations, 1, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&_histogram[_bucket(bytes)], 1, __ATOMIC_RELAXED);
+            size_t peak = _load(_peak_bytes);
+            while (live > peak && !__atomic_compare_exchange_n(&_peak_bytes, &peak, live, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                ;
+        }
+
+        void record_deallocation(size_t bytes) {
+            __atomic_sub_fetch(&_live_bytes, bytes, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&_deallocations, 1, __ATOMIC_RELAXED);
+        }
+
+        // Zeroes the counters, live bytes included; only meaningful while
+        // nothing allocated through this object is alive.
+        void reset() {
+            _live_bytes = 0;
+            _peak_bytes = 0;
+            _total_bytes = 0;
+            _allocations = 0;
+            _deallocations = 0;
+            for (size_t i = 0; i < histogram_buckets; ++i)
+                _histogram[i] = 0;
+        }
+
+        void print(std::ostream& os) const {
+            os << _tag << ": " << live_bytes() << " bytes live in " << live_allocations()
+               << " blocks, peak " << peak_bytes() << ", " << allocations() << " allocations of "
+               << total_bytes() << " bytes\n";
+            for (size_t b = 0; b < histogram_buckets; ++b)
+                if (histogram(b) != 0)
+                    os << "    [" << (size_t(1) << b) << ", " << (b + 1 < histogram_buckets ? size_t(1) << (b + 1) : 0)
+                       << "): " << histogram(b) << "\n";
+        }
+
+        static void print_all(std::ostream& os) {
+            pthread_mutex_lock(&_registry_lock());
+            for (alloc_stats* s = _registry(); s != NULL; s = s->_next)
+                s->print(os);
+            pthread_mutex_unlock(&_registry_lock());
+        }
+
+        // Used by tracking allocators constructed without stats.
+        static alloc_stats& global() {
+            static alloc_stats stats("global");
+            return stats;
+        }
+
+    private:
+        const char* _tag;
+        size_t _live_bytes;
+        size_t _peak_bytes;
+        size_t _total_bytes;
+        size_t _allocations;
+        size_t _deallocations;
+        size_t _histogram[histogram_buckets];
+        alloc_stats* _prev;
+        alloc_stats* _next;
+
+        alloc_stats(const alloc_stats&);
+        alloc_stats& operator=(const alloc_stats&);
+
+        static size_t _load(const size_t& counter) { return __atomic_load_n(&counter, __ATOMIC_RELAXED); }
+
+        static size_t _bucket(size_t bytes) {
+            return bytes == 0 ? 0 : sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl(bytes);
+        }
+
+        static alloc_stats*& _registry() {
+            static alloc_stats* head = NULL;
+            return head;
+        }
+
+        static pthread_mutex_t& _registry_lock() {
+            static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+            return lock;
+        }
+
+        void _link() {
+            pthread_mutex_lock(&_registry_lock());
+            _next = _registry();
+            if (_next != NULL)
+                _next->_prev = this;
+            _registry() = this;
+            pthread_mutex_unlock(&_registry_lock());
+        }
+
+        void _unlink() {
+            pthread_mutex_lock(&_registry_lock());
+            if (_prev != NULL)
+                _prev->_next = _next;
+            else
+                _registry() = _next;
+            if (_next != NULL)
+                _next->_prev = _prev;
+            pthread_mutex_unlock(&_registry_lock());
+        }
+    };
+
+    // Wraps Alloc and records every allocation and deallocation in an
+    // alloc_stats. Copies and rebinds share the stats, so one object sees
+    // both the elements and the nodes of a container.
+    template<class T, class Alloc = std::allocator<T> >
+    class tracking_allocator: public basic_allocator<T> {
+    public:
+        typedef typename basic_allocator<T>::pointer pointer;
+        typedef typename basic_allocator<T>::size_type size_type;
+        typedef Alloc inner_allocator_type;
+
+        template<class U>
+        struct rebind { typedef tracking_allocator<U, typename Alloc::template rebind<U>::other> other; };
+
+        tracking_allocator(): _stats(&alloc_stats::global()) {}
+        tracking_allocator(alloc_stats* stats, const Alloc& inner = Alloc()): _inner(inner), _stats(stats) {}
+        tracking_allocator(const tracking_allocator& other): basic_allocator<T>(), _inner(other._inner), _stats(other._stats) {}
+        template<class U, class A>
+        tracking_allocator(const tracking_allocator<U, A>& other): _inner(other.inner()), _stats(other.stats()) {}
+        ~tracking_allocator() {}
+
+        tracking_allocator& operator=(const tracking_allocator& other) {
+            _inner = other._inner;
+            _stats = other._stats;
+            return *this;
+        }
+
+        pointer allocate(size_type n, const void* = 0) {
+            pointer p = _inner.allocate(n);
+            _stats->record_allocation(n * sizeof(T));
+            return p;
+        }
+
+        // Containers may hand back the null pointer of an empty buffer;
+        // that is not counted.
+        void deallocate(pointer p, size_type n) {
+            if (p == NULL)
+                return ;
+            _stats->record_deallocation(n * sizeof(T));
+            _inner.deallocate(p, n);
+        }
+
+        alloc_stats* stats() const { return _stats; }
+        const Alloc& inner() const { return _inner; }
+
+    private:
+        Alloc _inner;
+        alloc_stats* _stats;
+    };
+
+    template<class T, class A, class U, class B>
+    bool operator==(const tracking_allocator<T, A>& lhs, const tracking_allocator<U, B>& rhs) {
+        return lhs.stats() == rhs.stats() && lhs.inner() == rhs.inner();
+    }
+
+    template<class T, class A, class U, class B>
+    bool operator!=(const tracking_allocator<T, A>& lhs, const tracking_allocator<U, B>& rhs) { return !(lhs == rhs); }
+}
+
+#endif//FT_CONTAINERS_TRACKING_ALLOCATOR_HPP
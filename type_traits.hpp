@@ -1,6 +1,16 @@
 #ifndef FT_CONTAINERS_TYPE_TRAITS_HPP
 # define FT_CONTAINERS_TYPE_TRAITS_HPP
 # include <cstddef>
+# if __cplusplus >= 201103L
+#  include <utility>
+#  define FT_CONTAINERS_CXX11 1
+#  define FT_MOVE(x) std::move(x)
+#  define FT_MOVE_IF_NOEXCEPT(x) std::move_if_noexcept(x)
+# else
+#  define FT_CONTAINERS_CXX11 0
+#  define FT_MOVE(x) (x)
+#  define FT_MOVE_IF_NOEXCEPT(x) (x)
+# endif
 
 
 namespace ft {
@@ -106,5 +116,71 @@ namespace ft {
         static const bool value = true;
     };
 
+    template<class T, T v>
+    struct integral_constant {
+        static const T value = v;
+        typedef T value_type;
+        typedef integral_constant type;
+    };
+
+    typedef integral_constant<bool, true> true_type;
+    typedef integral_constant<bool, false> false_type;
+
+    template<class T, class U>
+    struct is_same: false_type {};
+
+    template<class T>
+    struct is_same<T, T>: true_type {};
+
+    template<class T> struct remove_const { typedef T type; };
+    template<class T> struct remove_const<const T> { typedef T type; };
+
+    template<class T> struct remove_volatile { typedef T type; };
+    template<class T> struct remove_volatile<volatile T> { typedef T type; };
+
+    template<class T>
+    struct remove_cv {
+        typedef typename remove_volatile<typename remove_const<T>::type>::type type;
+    };
+
+    template<class T> struct is_pointer: false_type {};
+    template<class T> struct is_pointer<T*>: true_type {};
+    template<class T> struct is_pointer<T* const>: true_type {};
+
+    template<class T> struct is_floating_point: false_type {};
+    template<> struct is_floating_point<float>: true_type {};
+    template<> struct is_floating_point<double>: true_type {};
+    template<> struct is_floating_point<long double>: true_type {};
+
+    template<class T>
+    struct is_arithmetic {
+        static const bool value = is_integral<typename remove_cv<T>::type>::value
+                || is_floating_point<typename remove_cv<T>::type>::value;
+    };
+
+    template<class T>
+    struct is_scalar {
+        static const bool value = is_arithmetic<T>::value || is_pointer<T>::value;
+    };
+
+    // Types whose copies may be made with memcpy and that need no destructor.
+    // Without compiler support only scalars are recognised.
+    template<class T>
+    struct is_trivially_copyable {
+# if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+        static const bool value = __is_trivially_copyable(T) && __has_trivial_destructor(T);
+# else
+        static const bool value = is_scalar<T>::value;
+# endif
+    };
+
+    // Types that may be moved to a new address with memcpy, leaving the old
+    // bytes abandoned without a destructor call. Specialise for class types
+    // that do not point into themselves to enable the fast paths for them.
+    template<class T>
+    struct is_trivially_relocatable {
+        static const bool value = is_trivially_copyable<T>::value;
+    };
+
 }// namespace ft
 #endif//FT_CONTAINERS_TYPE_TRAITS_HPP
@@ -1,6 +1,7 @@
 #ifndef FT_CONTAINERS_UTILITY_HPP
 # define FT_CONTAINERS_UTILITY_HPP
 # include <iostream>
+# include "type_traits.hpp"
 namespace ft {
     template<class T1, class T2>
     struct pair {
@@ -16,6 +17,23 @@ namespace ft {
         template< class U1, class U2 >
         pair( const pair<U1, U2>& p ): first(p.first), second(p.second) {}
 
+# if FT_CONTAINERS_CXX11
+        pair( const pair& other ) = default;
+        pair( pair&& other ) = default;
+
+        template< class U1, class U2 >
+        pair( U1&& x, U2&& y ): first(std::forward<U1>(x)), second(std::forward<U2>(y)) {}
+
+        template< class U1, class U2 >
+        pair( pair<U1, U2>&& p ): first(std::forward<U1>(p.first)), second(std::forward<U2>(p.second)) {}
+
+        pair& operator=( pair&& other ) {
+            first = std::move(other.first);
+            second = std::move(other.second);
+            return *this;
+        }
+# endif
+
         pair& operator=( const pair& other ) {
             if (this != & other) {
                 this->first = other.first;
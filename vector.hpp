@@ -5,16 +5,25 @@
 # include <stdexcept>
 # include <limits>
 # include <algorithm>
+# include <cstring>
+# include <cerrno>
+# include <climits>
+# include <unistd.h>
+# include <sys/uio.h>
 # include "algorithm.hpp"
 # include "vector_iterator.hpp"
 # include "type_traits.hpp"
+# include "memory.hpp"
+# include "growth_policy.hpp"
+# include "latency.hpp"
 
 namespace ft {
-template< class T, class Alloc = std::allocator<T> >
+template< class T, class Alloc = std::allocator<T>, class Growth = growth_double >
 class vector {
 public:
     typedef T value_type;
     typedef Alloc allocator_type;
+    typedef Growth growth_policy;
     typedef size_t size_type;
     typedef ptrdiff_t difference_type;
     typedef typename allocator_type::reference reference;
@@ -27,33 +36,31 @@ public:
     typedef reverse_vector_iterator<const_iterator> const_reverse_iterator;
 
 
-    vector(): _size(0), _capacity(0), _array(NULL), _allocator(allocator_type()) {}
-    explicit vector( const allocator_type & alloc ): _size(0), _capacity(0), _array(0), _allocator(alloc) {}
+    vector(): _size(0), _capacity(0), _array(NULL), _allocator(allocator_type()), _reallocations(0), _bytes_copied(0) {}
+    explicit vector( const allocator_type & alloc ): _size(0), _capacity(0), _array(0), _allocator(alloc), _reallocations(0), _bytes_copied(0) {}
 
     explicit vector( size_type count,
                     const T& value = T(),
-                    const allocator_type& alloc = allocator_type()): _size(count), _capacity(count) {
+                    const allocator_type& alloc = allocator_type()): _size(count), _capacity(count), _reallocations(0), _bytes_copied(0) {
         _allocator = alloc;
         _array = _allocator.allocate(count);
-        for (size_type i = 0; i < count; ++i)
-            _allocator.construct(_array + i, value);
+        _fill(_array, count, value);
     }
 
     template< class InputIt >
-    vector( InputIt first, InputIt last, const Alloc& alloc = Alloc(), typename enable_if<!is_integral<InputIt>::value, bool >::type = true ) {
+    vector( InputIt first, InputIt last, const Alloc& alloc = Alloc(), typename enable_if<!is_integral<InputIt>::value, bool >::type = true ):
+        _reallocations(0), _bytes_copied(0) {
         _allocator = alloc;
         _size = std::distance(first, last);
         _capacity = _size;
         _array = _allocator.allocate(_capacity);
-        for (size_type i = 0; i < _size; ++i, ++first)
-            _allocator.construct(_array + i, *first);
+        _copy(first, last, _array);
     }
 
-    vector( const vector& other ): _size(other.size()), _capacity(other.capacity()) {
+    vector( const vector& other ): _size(other.size()), _capacity(other.capacity()), _reallocations(0), _bytes_copied(0) {
         _allocator = other.get_allocator();
         _array = _allocator.allocate(_capacity);
-        for (size_type i = 0; i < _size; ++i)
-            _allocator.construct(_array + i, other[i]);
+        _copy(other.begin(), other.end(), _array);
     }
 
     ~vector() {
@@ -69,8 +76,7 @@ public:
             _size = other.size();
             _capacity = other.capacity();
             _array = _allocator.allocate(_capacity);
-            for (size_type i = 0; i < _size; ++i)
-                _allocator.construct(_array + i, other[i]);
+            _copy(other.begin(), other.end(), _array);
         }
         return *this;
     }
@@ -79,13 +85,29 @@ public:
     size_type capacity() const { return _capacity; }
     allocator_type get_allocator() const { return _allocator; }
 
+    memory_footprint memory_usage() const {
+        memory_footprint usage;
+        usage.payload = _size * sizeof(T);
+        usage.unused_capacity = (_capacity - _size) * sizeof(T);
+        return usage;
+    }
+
+    // Number of times this vector moved to a new buffer, and the bytes of
+    // live elements carried over by those moves.
+    size_type reallocation_count() const { return _reallocations; }
+    size_type bytes_copied() const { return _bytes_copied; }
+    void reset_telemetry() {
+        _reallocations = 0;
+        _bytes_copied = 0;
+    }
+
     void assign( size_type count, const T& value ) {
         _destroy_elements();
+        _size = 0;
         if (count > _capacity)
             reserve(count);
+        _fill(_array, count, value);
         _size = count;
-        for (size_type i = 0; i < _size; ++i)
-            _allocator.construct(_array + i, value);
     }
 
 //    typename enable_if<!is_integral<InputIt>::value, void >::type insert( iterator pos, InputIt first, InputIt last ) {
@@ -93,51 +115,97 @@ public:
     template< class InputIt >
     typename enable_if<!is_integral<InputIt>::value, void >::type assign( InputIt first, InputIt last ) {
         _destroy_elements();
+        _size = 0;
         size_t new_size = std::distance(first, last);
         if (new_size > _capacity)
             reserve(new_size);
+        _copy(first, last, _array);
         _size = new_size;
-        for (size_t i = 0; i < _size; ++i)
-            _allocator.construct(_array + i, first[i]);
     }
 
     void reserve( size_type new_cap ) {
+        FT_LATENCY_SCOPE(latency_vector_reserve);
         if (new_cap <= _capacity)
             return ;
-        pointer newarr = _allocator.allocate(new_cap);
-        size_t i = 0;
-        try {
-            for ( ; i < _size; ++i)
-                _allocator.construct(newarr + i, _array[i]);
-        }
-        catch (...) {
-            for (size_t j = 0; j < i; ++j)
-                _allocator.destroy(newarr + i);
-            _allocator.deallocate(newarr, new_cap);
-            throw;
+        _grow(new_cap, _in_place_growth());
+    }
+
+    void shrink_to_fit() {
+        if (_capacity == _size)
+            return ;
+        if (_size == 0) {
+            _allocator.deallocate(_array, _capacity);
+            _array = NULL;
+            _capacity = 0;
+            return ;
         }
-        _destroy_elements();
-        _allocator.deallocate(_array, _capacity);
-        _array = newarr;
-        _capacity = new_cap;
+        _grow(_size, _in_place_growth());
     }
 
     void resize( size_type count, T value = T() ) {
         if (count > _capacity)
             reserve(count);
-        for (size_t i = _size; i < count; ++i)
-            _allocator.construct(_array + i, value);
-        if (count < _size) {
+        if (count > _size)
+            _fill(_array + _size, count - _size, value);
+        else
             _destroy_elements(count);
-            _size = count;
+        _size = count;
+    }
+
+    // Like resize, but new elements are left uninitialized for the caller
+    // to fill, e.g. with read(2). Only for trivially copyable types.
+    void resize_uninitialized( size_type count ) {
+        typedef char requires_trivially_copyable_type[_trivial::value ? 1 : -1];
+        (void)sizeof(requires_trivially_copyable_type);
+        if (count > _capacity)
+            reserve(count);
+        _size = count;
+    }
+
+    // Reads up to max_bytes from fd straight into the spare capacity and
+    // appends what arrived. Returns the byte count, 0 at end of file or -1
+    // with errno set, as read(2) does; EINTR is retried.
+    ssize_t append_from_fd( int fd, size_type max_bytes ) {
+        typedef char requires_byte_sized_trivial_type[_trivial::value && sizeof(T) == 1 ? 1 : -1];
+        (void)sizeof(requires_byte_sized_trivial_type);
+        if (_size + max_bytes > _capacity)
+            reserve(_next_capacity(_size + max_bytes));
+        ssize_t n;
+        do
+            n = ::read(fd, _array + _size, max_bytes);
+        while (n < 0 && errno == EINTR);
+        if (n > 0)
+            _size += n;
+        return n;
+    }
+
+    // Writes the whole contents to fd. Returns the bytes written, which is
+    // short only if the descriptor would block or stops accepting bytes, or
+    // -1 with errno set if nothing could be written.
+    ssize_t write_to_fd( int fd ) const {
+        typedef char requires_byte_sized_trivial_type[_trivial::value && sizeof(T) == 1 ? 1 : -1];
+        (void)sizeof(requires_byte_sized_trivial_type);
+        size_type done = 0;
+        while (done < _size) {
+            ssize_t n = ::write(fd, _array + done, _size - done);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                if (done == 0)
+                    return -1;
+                break;
+            }
+            if (n == 0)
+                break;
+            done += n;
         }
+        return done;
     }
 
     void push_back( const T& value ) {
-        if (_capacity != 0 && _size == _capacity)
-            reserve(2 * _capacity);
-        if (_capacity == 0)
-            reserve(1);
+        FT_LATENCY_SCOPE(latency_vector_push_back);
+        if (_size == _capacity)
+            reserve(_next_capacity(_size + 1));
         _allocator.construct(_array + _size, value);
         ++_size;
     }
@@ -187,107 +255,65 @@ public:
     const_reverse_iterator rend() const { return const_reverse_iterator(begin() - 1); }
 
     iterator insert( iterator pos, const T& value ) {
+        FT_LATENCY_SCOPE(latency_vector_insert);
         return _insert(pos, 1, value);
     }
 
     void insert( iterator pos, size_type count, const T& value) {
+        FT_LATENCY_SCOPE(latency_vector_insert);
         _insert(pos, count, value);
     }
 
     iterator _insert( iterator pos, size_type count, const T& value) {
-        if (_capacity != 0 && _size + count > _capacity) {
-            size_type ncap = _capacity;
-            if (_size + count > 2 * _capacity)
-                ncap = _size + count;
-            else
-                ncap = 2 * _capacity;
+        if (count == 0)
+            return pos;
+        T copy(value);
+        if (_size + count > _capacity && _in_place_growth::value) {
+            size_type index = pos - begin();
+            reserve(_next_capacity(_size + count));
+            pos = _array + index;
+        }
+        if (_size + count > _capacity) {
+            size_type index = pos - begin();
+            size_type ncap = _next_capacity(_size + count);
             T *newarr = _allocator.allocate(ncap);
-            T *end_arr;
             try {
-                end_arr = _copy(begin(), pos, newarr);
-                end_arr = _fill(end_arr, count, value);
-                _copy(pos, end(), end_arr);
+                _fill(newarr + index, count, copy);
             } catch (...) {
-                _destroy_temp_arr(newarr, end_arr);
                 _allocator.deallocate(newarr, ncap);
                 throw;
             }
-            _destroy_elements();
-            _allocator.deallocate(_array, _capacity);
-            _array = newarr;
-            _capacity = ncap;
-            _size += count;
-            return iterator(end_arr);
-        }
-        else if (end() - pos < static_cast<difference_type >(count)) {
-            _copy(pos, end(), pos + count);
-            difference_type index = end() - pos;
-            try {
-                _fill(_array + _size, count - index, value);
-            }
-            catch (...) {
-                _destroy_temp_arr(pos + count, _array + _size + count);
-                throw;
-            }
-            _size += count;
-            _fill(pos, index, value);
-        }
-        else {
-            iterator _end = end();
-            _size += count;
-            _copy(pos, _end, pos + count);
-            _fill(pos, count, value);
+            _move_into(newarr, ncap, index, count, _relocatable());
+            return iterator(_array + index);
         }
+        _insert_fill(pos, count, copy, _trivial());
         return pos;
     }
 
     template< class InputIt >
     typename enable_if<!is_integral<InputIt>::value, void >::type insert( iterator pos, InputIt first, InputIt last ) {
+        FT_LATENCY_SCOPE(latency_vector_insert);
         difference_type count = last - first;
+        if (count + _size > _capacity && _in_place_growth::value) {
+            size_type index = pos - begin();
+            reserve(_next_capacity(_size + count));
+            pos = _array + index;
+        }
         if (count + _size > _capacity) {
-            size_type ncap = _capacity;
-            if (_size + count > 2 * _capacity)
-                ncap = _size + count;
-            else
-                ncap = 2 * _capacity;
+            size_type index = pos - begin();
+            size_type ncap = _next_capacity(_size + count);
             T* newarr = _allocator.allocate(ncap);
-            T* endarr;
-            try {
-                endarr = _copy(begin(), pos, newarr);
-                endarr = _copy(first, last, endarr);
-                _copy(pos, end(), endarr);
-            }
-            catch (...) {
-                _destroy_temp_arr(newarr, endarr);
-                _allocator.deallocate(newarr, _size + ncap);
-                throw;
-            }
-            _destroy_elements();
-            _allocator.deallocate(_array, _capacity);
-            _array = newarr;
-            _capacity = ncap;
-            _size += count;
-        }
-        else if (end() - pos < count) {
-            _copy(pos, end(), pos + count);
-            difference_type index = end() - pos;
             try {
-//                _fill(_array + _size, count - index, value);
-                _copy(first + index, last, _array + _size);
+                _copy(first, last, newarr + index);
             }
             catch (...) {
-                _destroy_temp_arr(pos + count, _array + _size + count);
+                _allocator.deallocate(newarr, ncap);
                 throw;
             }
-            _size += count;
-            _copy(first, last - (count - index), pos);
-        }
-        else {
-            iterator _end = end();
-            _size += count;
-            _copy(pos, _end, pos + count);
-            _copy(first, last, pos);
+            _move_into(newarr, ncap, index, count, _relocatable());
         }
+        else if (count != 0)
+            _insert_copy(pos, first, last, _trivial());
     }
 
     iterator erase( iterator pos ) {
@@ -296,20 +322,112 @@ public:
     }
 
     iterator erase( iterator first, iterator last ) {
+        FT_LATENCY_SCOPE(latency_vector_erase);
         if (first >= last)
             return last;
         else if (first == end())
             return end();
-        size_type count_del = 0;
         size_type start = first - begin();
-        for ( iterator it = first ; it != last ; ++it, ++count_del )
-            _allocator.destroy(it);
-        for ( size_type i = 0 ; i != _size - count_del - start; ++i, ++first )
-            _allocator.construct(_array + start + i, _array[start + i + count_del]);
-        _size -= count_del;
+        _close_gap(first, last, _trivial());
         return iterator(_array + start);
     }
 
+    // O(1) removal that fills the hole with the last element, so the order
+    // of the remaining elements is not kept.
+    iterator erase_unordered( iterator pos ) {
+        T* last = _array + _size - 1;
+        if (pos != last)
+            *pos = FT_MOVE(*last);
+        pop_back();
+        return pos;
+    }
+
+    // Removes every element satisfying pred in one pass and returns how many
+    // were removed.
+    template< class UnaryPredicate >
+    size_type erase_if( UnaryPredicate pred ) {
+        size_type old_size = _size;
+        _compact(pred, _trivial());
+        return old_size - _size;
+    }
+
+# if FT_CONTAINERS_CXX11
+    vector( vector&& other ) noexcept: _size(other._size), _capacity(other._capacity), _array(other._array), _allocator(std::move(other._allocator)),
+        _reallocations(0), _bytes_copied(0) {
+        other._size = 0;
+        other._capacity = 0;
+        other._array = NULL;
+    }
+
+    vector& operator=( vector&& other ) noexcept {
+        if (this != &other) {
+            _destroy_elements();
+            _allocator.deallocate(_array, _capacity);
+            _size = other._size;
+            _capacity = other._capacity;
+            _array = other._array;
+            _allocator = std::move(other._allocator);
+            other._size = 0;
+            other._capacity = 0;
+            other._array = NULL;
+        }
+        return *this;
+    }
+
+    void push_back( T&& value ) {
+        FT_LATENCY_SCOPE(latency_vector_push_back);
+        emplace(end(), std::move(value));
+    }
+
+    template< class... Args >
+    reference emplace_back( Args&&... args ) {
+        FT_LATENCY_SCOPE(latency_vector_push_back);
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
+
+    iterator insert( iterator pos, T&& value ) {
+        FT_LATENCY_SCOPE(latency_vector_insert);
+        return emplace(pos, std::move(value));
+    }
+
+    // On growth the new element is built in the new buffer before the old
+    // ones are relocated, so arguments referring into the vector stay valid.
+    // Allocators that resize blocks in place grow through reserve() as
+    // push_back does, with the element built beforehand for the same reason.
+    template< class... Args >
+    iterator emplace( iterator pos, Args&&... args ) {
+        size_type index = pos - begin();
+        if (_size == _capacity && _in_place_growth::value) {
+            T tmp(std::forward<Args>(args)...);
+            reserve(_next_capacity(_size + 1));
+            return emplace(_array + index, std::move(tmp));
+        }
+        if (_size == _capacity) {
+            size_type ncap = _next_capacity(_size + 1);
+            T* newarr = _allocator.allocate(ncap);
+            try {
+                _allocator.construct(newarr + index, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                _allocator.deallocate(newarr, ncap);
+                throw;
+            }
+            _move_into(newarr, ncap, index, 1, _relocatable());
+            return iterator(_array + index);
+        }
+        else if (pos == end())
+            _allocator.construct(_array + _size, std::forward<Args>(args)...);
+        else {
+            T tmp(std::forward<Args>(args)...);
+            _allocator.construct(_array + _size, std::move(_array[_size - 1]));
+            _move_backward(pos, _array + _size - 1, _array + _size);
+            *pos = std::move(tmp);
+        }
+        ++_size;
+        return iterator(_array + index);
+    }
+# endif
+
     void swap( vector& other ) {
         std::swap(_size, other._size);
         std::swap(_capacity, other._capacity);
@@ -323,6 +441,17 @@ private:
     size_t _capacity;
     T* _array;
     allocator_type _allocator;
+    size_t _reallocations;
+    size_t _bytes_copied;
+
+    size_type _next_capacity(size_type required) const {
+        return Growth::next_capacity(_capacity, required, sizeof(T));
+    }
+
+    void _record_reallocation() {
+        ++_reallocations;
+        _bytes_copied += _size * sizeof(T);
+    }
 
     void _destroy_elements(size_type count = 0) {
         for (size_t i = count; i < _size; ++i)
@@ -334,6 +463,228 @@ private:
             _allocator.destroy(start);
     }
 
+    typedef integral_constant<bool, is_trivially_copyable<T>::value> _trivial;
+    typedef integral_constant<bool, is_trivially_relocatable<T>::value> _relocatable;
+
+    typedef integral_constant<bool, is_trivially_relocatable<T>::value
+            && is_reallocatable_allocator<Alloc>::value> _in_place_growth;
+
+    // Moves the elements to a buffer of new_cap slots, larger or smaller.
+    // Lets the allocator resize the block itself when it can, which for
+    // huge buffers remaps pages instead of copying them.
+    void _grow(size_type new_cap, true_type) {
+        _record_reallocation();
+        _array = _allocator.reallocate(_array, _capacity, new_cap);
+        _capacity = new_cap;
+    }
+
+    void _grow(size_type new_cap, false_type) {
+        pointer newarr = _allocator.allocate(new_cap);
+        try {
+            _relocate(_array, _array + _size, newarr, _relocatable());
+        }
+        catch (...) {
+            _allocator.deallocate(newarr, new_cap);
+            throw;
+        }
+        _record_reallocation();
+        _allocator.deallocate(_array, _capacity);
+        _array = newarr;
+        _capacity = new_cap;
+    }
+
+    // Takes newarr, a buffer of ncap slots where the caller has constructed
+    // count new elements at index, as the storage, and moves the old
+    // elements around them. Those that are not trivially relocatable are
+    // copied, or moved when that cannot throw, and destroyed only once all
+    // of them made it; on a throw the new buffer and what it holds are
+    // freed and the vector is left as it was.
+    void _move_into(T* newarr, size_type ncap, size_type index, size_type count, true_type) {
+        _relocate(_array, _array + index, newarr, true_type());
+        _relocate(_array + index, _array + _size, newarr + index + count, true_type());
+        _adopt(newarr, ncap, count);
+    }
+
+    void _move_into(T* newarr, size_type ncap, size_type index, size_type count, false_type) {
+        try {
+            _move_construct(_array, _array + index, newarr);
+            try {
+                _move_construct(_array + index, _array + _size, newarr + index + count);
+            }
+            catch (...) {
+                _destroy_temp_arr(newarr, newarr + index);
+                throw;
+            }
+        }
+        catch (...) {
+            _destroy_temp_arr(newarr + index, newarr + index + count);
+            _allocator.deallocate(newarr, ncap);
+            throw;
+        }
+        _destroy_elements();
+        _adopt(newarr, ncap, count);
+    }
+
+    void _adopt(T* newarr, size_type ncap, size_type count) {
+        _record_reallocation();
+        _allocator.deallocate(_array, _capacity);
+        _array = newarr;
+        _capacity = ncap;
+        _size += count;
+    }
+
+    // Moves [first, last) into raw memory at p, leaving the source raw.
+    T* _relocate(T* first, T* last, T* p, true_type) {
+        if (first != last)
+            std::memmove(static_cast<void*>(p), static_cast<const void*>(first), (last - first) * sizeof(T));
+        return p + (last - first);
+    }
+
+    T* _relocate(T* first, T* last, T* p, false_type) {
+        T* end = _move_construct(first, last, p);
+        _destroy_temp_arr(first, last);
+        return end;
+    }
+
+    // In-place insertion when the capacity suffices. Trivial types shift the
+    // tail with one memmove; the others construct into the raw slots past
+    // the end and assign into the live ones.
+    void _insert_fill(T* pos, size_type count, const T& value, true_type) {
+        std::memmove(static_cast<void*>(pos + count), static_cast<const void*>(pos), (_array + _size - pos) * sizeof(T));
+        _fill(pos, count, value);
+        _size += count;
+    }
+
+    void _insert_fill(T* pos, size_type count, const T& value, false_type) {
+        T* old_end = _array + _size;
+        size_type after = old_end - pos;
+        if (after > count) {
+            _move_construct(old_end - count, old_end, old_end);
+            _size += count;
+            _move_backward(pos, old_end - count, old_end);
+            std::fill(pos, pos + count, value);
+        }
+        else {
+            _fill(old_end, count - after, value);
+            _size += count - after;
+            _move_construct(pos, old_end, pos + count);
+            _size += after;
+            std::fill(pos, old_end, value);
+        }
+    }
+
+    template<class It>
+    void _insert_copy(T* pos, It first, It last, true_type) {
+        size_type count = std::distance(first, last);
+        std::memmove(static_cast<void*>(pos + count), static_cast<const void*>(pos), (_array + _size - pos) * sizeof(T));
+        _copy(first, last, pos);
+        _size += count;
+    }
+
+    template<class It>
+    void _insert_copy(T* pos, It first, It last, false_type) {
+        size_type count = std::distance(first, last);
+        T* old_end = _array + _size;
+        size_type after = old_end - pos;
+        if (after > count) {
+            _move_construct(old_end - count, old_end, old_end);
+            _size += count;
+            _move_backward(pos, old_end - count, old_end);
+            std::copy(first, last, pos);
+        }
+        else {
+            It mid = first;
+            std::advance(mid, after);
+            _copy(mid, last, old_end);
+            _size += count - after;
+            _move_construct(pos, old_end, pos + count);
+            _size += after;
+            std::copy(first, mid, pos);
+        }
+    }
+
+    void _close_gap(T* first, T* last, true_type) {
+        T* old_end = _array + _size;
+        std::memmove(static_cast<void*>(first), static_cast<const void*>(last), (old_end - last) * sizeof(T));
+        _size -= last - first;
+    }
+
+    void _close_gap(T* first, T* last, false_type) {
+        T* new_end = first;
+        for (T* p = last; p != _array + _size; ++p, ++new_end)
+            *new_end = FT_MOVE(*p);
+        _destroy_elements(new_end - _array);
+        _size = new_end - _array;
+    }
+
+    // Kept elements are moved down in runs, one memmove per run. Like
+    // remove_if, pred is called once per element.
+    template< class UnaryPredicate >
+    void _compact(UnaryPredicate& pred, true_type) {
+        T* end = _array + _size;
+        T* out = _array;
+        T* run = _array;
+        for (T* p = _array; p != end; ++p) {
+            if (!pred(*p))
+                continue;
+            out = _move_run(run, p, out);
+            run = p + 1;
+        }
+        out = _move_run(run, end, out);
+        _size = out - _array;
+    }
+
+    static T* _move_run(T* first, T* last, T* out) {
+        if (out != first && first != last)
+            std::memmove(static_cast<void*>(out), static_cast<const void*>(first), (last - first) * sizeof(T));
+        return out + (last - first);
+    }
+
+    template< class UnaryPredicate >
+    void _compact(UnaryPredicate& pred, false_type) {
+        T* new_end = ft::remove_if(_array, _array + _size, pred);
+        _destroy_elements(new_end - _array);
+        _size = new_end - _array;
+    }
+
+    // Constructs from rvalues when the element type can be moved without
+    // throwing, and falls back to copies otherwise.
+    T* _move_construct(T* begin, T* end, T* p) {
+        T* ps = p;
+        try {
+            for ( ; begin != end ; ++begin, ++p)
+                _allocator.construct(p, FT_MOVE_IF_NOEXCEPT(*begin));
+        }
+        catch (...) {
+            _destroy_temp_arr(ps, p);
+            throw;
+        }
+        return p;
+    }
+
+    static void _move_backward(T* first, T* last, T* d_last) {
+        while (first != last)
+            *--d_last = FT_MOVE(*--last);
+    }
+
+    T* _copy(const T* begin, const T* end, T* p) {
+        return _copy_contiguous(begin, end, p, _trivial());
+    }
+
+    T* _copy(T* begin, T* end, T* p) {
+        return _copy_contiguous(begin, end, p, _trivial());
+    }
+
+    T* _copy_contiguous(const T* begin, const T* end, T* p, true_type) {
+        if (begin != end)
+            std::memcpy(static_cast<void*>(p), static_cast<const void*>(begin), (end - begin) * sizeof(T));
+        return p + (end - begin);
+    }
+
+    T* _copy_contiguous(const T* begin, const T* end, T* p, false_type) {
+        return _copy<const T*>(begin, end, p);
+    }
+
     template<class It>
     T* _copy(It begin, It end, T* p) {
         T* ps = p;
@@ -349,7 +700,23 @@ private:
     }
 
     T* _fill(T* p, size_type n, const T& value) {
-        T* ps;
+        return _fill(p, n, value, _trivial());
+    }
+
+    T* _fill(T* p, size_type n, const T& value, true_type) {
+        if (n == 0)
+            return p;
+        if (sizeof(T) == 1) {
+            unsigned char byte;
+            std::memcpy(&byte, &value, 1);
+            std::memset(static_cast<void*>(p), byte, n);
+            return p + n;
+        }
+        return std::fill_n(p, n, value);
+    }
+
+    T* _fill(T* p, size_type n, const T& value, false_type) {
+        T* ps = p;
         try {
             for (; n != 0; --n, ++p)
                 _allocator.construct(p, value);
@@ -363,38 +730,115 @@ private:
 
 };
 
-template< class T, class Alloc >
-bool operator==( const ft::vector<T,Alloc>& lhs,
-                const ft::vector<T,Alloc>& rhs ) {
+template< class T, class Alloc, class Growth >
+bool operator==( const ft::vector<T,Alloc,Growth>& lhs,
+                const ft::vector<T,Alloc,Growth>& rhs ) {
     return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template< class T, class Alloc >
-bool operator!=( const ft::vector<T,Alloc>& lhs,
-                const ft::vector<T,Alloc>& rhs ) { return !(lhs == rhs); }
+template< class T, class Alloc, class Growth >
+bool operator!=( const ft::vector<T,Alloc,Growth>& lhs,
+                const ft::vector<T,Alloc,Growth>& rhs ) { return !(lhs == rhs); }
 
-template< class T, class Alloc >
-bool operator<( const ft::vector<T,Alloc>& lhs,
-               const ft::vector<T,Alloc>& rhs ) {
+template< class T, class Alloc, class Growth >
+bool operator<( const ft::vector<T,Alloc,Growth>& lhs,
+               const ft::vector<T,Alloc,Growth>& rhs ) {
     return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template< class T, class Alloc >
-bool operator>( const ft::vector<T,Alloc>& lhs,
-                const ft::vector<T,Alloc>& rhs ) { return rhs < lhs; }
+template< class T, class Alloc, class Growth >
+bool operator>( const ft::vector<T,Alloc,Growth>& lhs,
+                const ft::vector<T,Alloc,Growth>& rhs ) { return rhs < lhs; }
 
-template< class T, class Alloc >
-bool operator<=( const ft::vector<T,Alloc>& lhs,
-                const ft::vector<T,Alloc>& rhs ) { return !(rhs < lhs); }
+template< class T, class Alloc, class Growth >
+bool operator<=( const ft::vector<T,Alloc,Growth>& lhs,
+                const ft::vector<T,Alloc,Growth>& rhs ) { return !(rhs < lhs); }
 
-template< class T, class Alloc >
-bool operator>=( const ft::vector<T,Alloc>& lhs,
-                const ft::vector<T,Alloc>& rhs ) { return !(lhs < rhs); }
+template< class T, class Alloc, class Growth >
+bool operator>=( const ft::vector<T,Alloc,Growth>& lhs,
+                const ft::vector<T,Alloc,Growth>& rhs ) { return !(lhs < rhs); }
 
-template< class T, class Alloc >
-void swap( ft::vector<T,Alloc>& lhs,
-          ft::vector<T,Alloc>& rhs ) { return lhs.swap(rhs); }
+template< class T, class Alloc, class Growth >
+void swap( ft::vector<T,Alloc,Growth>& lhs,
+          ft::vector<T,Alloc,Growth>& rhs ) { return lhs.swap(rhs); }
+
+template< class T, class Alloc, class Growth, class UnaryPredicate >
+typename ft::vector<T,Alloc,Growth>::size_type erase_if( ft::vector<T,Alloc,Growth>& vec, UnaryPredicate pred ) {
+    return vec.erase_if(pred);
+}
+
+// Scatter read: one readv(2) fills the spare capacity of vecs[0], then
+// vecs[1], and so on, appending to each what landed in it. Reserve the
+// wanted room beforehand; capacity is not grown here, and at most IOV_MAX
+// vectors take part. Returns like read(2).
+template< class T, class Alloc, class Growth >
+ssize_t readv_into( int fd, ft::vector<T,Alloc,Growth>* const* vecs, size_t count ) {
+    typedef char requires_byte_sized_type[sizeof(T) == 1 ? 1 : -1];
+    (void)sizeof(requires_byte_sized_type);
+    if (count > IOV_MAX)
+        count = IOV_MAX;
+    ft::vector<struct iovec> iov(count);
+    for (size_t i = 0; i < count; ++i) {
+        iov[i].iov_base = vecs[i]->data() + vecs[i]->size();
+        iov[i].iov_len = vecs[i]->capacity() - vecs[i]->size();
+    }
+    ssize_t n;
+    do
+        n = ::readv(fd, iov.data(), static_cast<int>(count));
+    while (n < 0 && errno == EINTR);
+    size_t left = n > 0 ? n : 0;
+    for (size_t i = 0; i < count && left != 0; ++i) {
+        size_t got = std::min(left, iov[i].iov_len);
+        vecs[i]->resize_uninitialized(vecs[i]->size() + got);
+        left -= got;
+    }
+    return n;
+}
+
+// Gather write of the contents of vecs[0..count) with one writev(2) per
+// attempt, continuing after short writes. Returns like write_to_fd.
+template< class T, class Alloc, class Growth >
+ssize_t writev_from( int fd, const ft::vector<T,Alloc,Growth>* const* vecs, size_t count ) {
+    typedef char requires_byte_sized_type[sizeof(T) == 1 ? 1 : -1];
+    (void)sizeof(requires_byte_sized_type);
+    ft::vector<struct iovec> iov;
+    iov.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (vecs[i]->empty())
+            continue;
+        struct iovec v;
+        v.iov_base = const_cast<T*>(vecs[i]->data());
+        v.iov_len = vecs[i]->size();
+        iov.push_back(v);
+    }
+    size_t first = 0;
+    size_t done = 0;
+    while (first < iov.size()) {
+        size_t batch = std::min<size_t>(iov.size() - first, IOV_MAX);
+        ssize_t n = ::writev(fd, iov.data() + first, static_cast<int>(batch));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (done == 0)
+                return -1;
+            break;
+        }
+        if (n == 0)
+            break;
+        done += n;
+        for (size_t left = n; left != 0 && first < iov.size(); ) {
+            size_t step = std::min(left, iov[first].iov_len);
+            iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + step;
+            iov[first].iov_len -= step;
+            left -= step;
+            if (iov[first].iov_len == 0)
+                ++first;
+        }
+    }
+    return done;
+}
 }
 
+# include "vector_bool.hpp"
 
 #endif//FT_CONTAINERS_VECTOR_HPP
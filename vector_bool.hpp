@@ -0,0 +1,464 @@
+#ifndef FT_CONTAINERS_VECTOR_BOOL_HPP
+# define FT_CONTAINERS_VECTOR_BOOL_HPP
+# include <cstddef>
+# include <climits>
+# include <stdexcept>
+# include <iterator>
+# include <algorithm>
+# include "vector.hpp"
+
+namespace ft {
+    typedef unsigned long bit_word;
+    static const size_t bits_per_word = sizeof(bit_word) * CHAR_BIT;
+
+    // Stands in for bool& to one bit of a word.
+    class bit_reference {
+    public:
+        bit_reference(bit_word* word, bit_word mask): _word(word), _mask(mask) {}
+
+        operator bool() const { return (*_word & _mask) != 0; }
+        bool operator~() const { return (*_word & _mask) == 0; }
+
+        bit_reference& operator=(bool value) {
+            if (value)
+                *_word |= _mask;
+            else
+                *_word &= ~_mask;
+            return *this;
+        }
+
+        bit_reference& operator=(const bit_reference& other) { return *this = bool(other); }
+
+        void flip() { *_word ^= _mask; }
+
+    private:
+        bit_word* _word;
+        bit_word _mask;
+    };
+
+    inline void swap(bit_reference a, bit_reference b) {
+        bool tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    // Word pointer plus bit offset in [0, bits_per_word).
+    class bit_iterator_base {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef bool value_type;
+        typedef ptrdiff_t difference_type;
+
+        bit_iterator_base(bit_word* word, size_t bit): _word(word), _bit(bit) {}
+
+        bool operator==(const bit_iterator_base& other) const { return _word == other._word && _bit == other._bit; }
+        bool operator!=(const bit_iterator_base& other) const { return !(*this == other); }
+        bool operator<(const bit_iterator_base& other) const {
+            return _word < other._word || (_word == other._word && _bit < other._bit);
+        }
+        bool operator>(const bit_iterator_base& other) const { return other < *this; }
+        bool operator<=(const bit_iterator_base& other) const { return !(other < *this); }
+        bool operator>=(const bit_iterator_base& other) const { return !(*this < other); }
+
+        difference_type operator-(const bit_iterator_base& other) const {
+            return (_word - other._word) * static_cast<difference_type>(bits_per_word)
+                    + static_cast<difference_type>(_bit) - static_cast<difference_type>(other._bit);
+        }
+
+    protected:
+        bit_word* _word;
+        size_t _bit;
+
+        void _increment() {
+            if (++_bit == bits_per_word) {
+                _bit = 0;
+                ++_word;
+            }
+        }
+
+        void _decrement() {
+            if (_bit-- == 0) {
+                _bit = bits_per_word - 1;
+                --_word;
+            }
+        }
+
+        void _advance(difference_type n) {
+            difference_type pos = n + static_cast<difference_type>(_bit);
+            difference_type words = pos / static_cast<difference_type>(bits_per_word);
+            pos %= static_cast<difference_type>(bits_per_word);
+            if (pos < 0) {
+                pos += bits_per_word;
+                --words;
+            }
+            _word += words;
+            _bit = static_cast<size_t>(pos);
+        }
+
+        bit_word _mask() const { return bit_word(1) << _bit; }
+    };
+
+    class bit_iterator: public bit_iterator_base {
+    public:
+        typedef bit_reference reference;
+        typedef bit_reference* pointer;
+
+        bit_iterator(): bit_iterator_base(NULL, 0) {}
+        bit_iterator(bit_word* word, size_t bit): bit_iterator_base(word, bit) {}
+
+        reference operator*() const { return reference(_word, _mask()); }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        bit_iterator& operator++() { _increment(); return *this; }
+        bit_iterator operator++(int) { bit_iterator tmp(*this); _increment(); return tmp; }
+        bit_iterator& operator--() { _decrement(); return *this; }
+        bit_iterator operator--(int) { bit_iterator tmp(*this); _decrement(); return tmp; }
+        bit_iterator& operator+=(difference_type n) { _advance(n); return *this; }
+        bit_iterator& operator-=(difference_type n) { _advance(-n); return *this; }
+        bit_iterator operator+(difference_type n) const { bit_iterator tmp(*this); return tmp += n; }
+        bit_iterator operator-(difference_type n) const { bit_iterator tmp(*this); return tmp -= n; }
+        difference_type operator-(const bit_iterator_base& other) const { return bit_iterator_base::operator-(other); }
+    };
+
+    class bit_const_iterator: public bit_iterator_base {
+    public:
+        typedef bool reference;
+        typedef const bool* pointer;
+
+        bit_const_iterator(): bit_iterator_base(NULL, 0) {}
+        bit_const_iterator(const bit_word* word, size_t bit): bit_iterator_base(const_cast<bit_word*>(word), bit) {}
+        bit_const_iterator(const bit_iterator& it): bit_iterator_base(it) {}
+
+        reference operator*() const { return (*_word & _mask()) != 0; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        bit_const_iterator& operator++() { _increment(); return *this; }
+        bit_const_iterator operator++(int) { bit_const_iterator tmp(*this); _increment(); return tmp; }
+        bit_const_iterator& operator--() { _decrement(); return *this; }
+        bit_const_iterator operator--(int) { bit_const_iterator tmp(*this); _decrement(); return tmp; }
+        bit_const_iterator& operator+=(difference_type n) { _advance(n); return *this; }
+        bit_const_iterator& operator-=(difference_type n) { _advance(-n); return *this; }
+        bit_const_iterator operator+(difference_type n) const { bit_const_iterator tmp(*this); return tmp += n; }
+        bit_const_iterator operator-(difference_type n) const { bit_const_iterator tmp(*this); return tmp -= n; }
+        difference_type operator-(const bit_iterator_base& other) const { return bit_iterator_base::operator-(other); }
+    };
+
+// One bit per element, packed into bit_words kept in an ft::vector. Bits
+// past size() in the last word are always zero, so whole words can be
+// counted, compared and combined without masking.
+template< class Alloc, class Growth >
+class vector<bool, Alloc, Growth> {
+public:
+    typedef bool value_type;
+    typedef Alloc allocator_type;
+    typedef Growth growth_policy;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef bit_reference reference;
+    typedef bool const_reference;
+    typedef bit_iterator iterator;
+    typedef bit_const_iterator const_iterator;
+    typedef reverse_vector_iterator<iterator> reverse_iterator;
+    typedef reverse_vector_iterator<const_iterator> const_reverse_iterator;
+    typedef typename Alloc::template rebind<bit_word>::other word_allocator_type;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+    vector(): _size(0) {}
+    explicit vector( const allocator_type& alloc ): _words(word_allocator_type(alloc)), _size(0) {}
+
+    explicit vector( size_type count,
+                    const bool& value = false,
+                    const allocator_type& alloc = allocator_type()):
+        _words(_word_count(count), value ? ~bit_word(0) : bit_word(0), word_allocator_type(alloc)), _size(count) {
+        _clear_tail();
+    }
+
+    template< class InputIt >
+    vector( InputIt first, InputIt last, const Alloc& alloc = Alloc(), typename enable_if<!is_integral<InputIt>::value, bool >::type = true ):
+        _words(word_allocator_type(alloc)), _size(0) {
+        for ( ; first != last ; ++first)
+            push_back(*first);
+    }
+
+    vector( const vector& other ): _words(other._words), _size(other._size) {}
+    ~vector() {}
+
+    vector& operator=( const vector& other ) {
+        if (this != &other) {
+            _words = other._words;
+            _size = other._size;
+        }
+        return *this;
+    }
+
+    void assign( size_type count, const bool& value ) {
+        _words.assign(_word_count(count), value ? ~bit_word(0) : bit_word(0));
+        _size = count;
+        _clear_tail();
+    }
+
+    template< class InputIt >
+    typename enable_if<!is_integral<InputIt>::value, void >::type assign( InputIt first, InputIt last ) {
+        clear();
+        for ( ; first != last ; ++first)
+            push_back(*first);
+    }
+
+    size_type size() const { return _size; }
+    size_type capacity() const { return _words.capacity() * bits_per_word; }
+    bool empty() const { return _size == 0; }
+    size_type max_size() const { return _words.max_size() * bits_per_word; }
+    allocator_type get_allocator() const { return allocator_type(_words.get_allocator()); }
+
+    // The packed words, bit i of the vector being bit i % bits_per_word of
+    // word i / bits_per_word.
+    const bit_word* word_data() const { return _words.data(); }
+    size_type word_count() const { return _words.size(); }
+
+    // One bit of payload per element; the rest of the words is unused.
+    memory_footprint memory_usage() const {
+        memory_footprint usage;
+        usage.payload = (_size + CHAR_BIT - 1) / CHAR_BIT;
+        usage.unused_capacity = _words.capacity() * sizeof(bit_word) - usage.payload;
+        return usage;
+    }
+
+    void reserve( size_type new_cap ) { _words.reserve(_word_count(new_cap)); }
+    void shrink_to_fit() { _words.shrink_to_fit(); }
+
+    void resize( size_type count, bool value = false ) {
+        if (count > _size)
+            insert(end(), count - _size, value);
+        else {
+            _size = count;
+            _words.resize(_word_count(count));
+            _clear_tail();
+        }
+    }
+
+    void push_back( const bool& value ) {
+        if (_size % bits_per_word == 0)
+            _words.push_back(0);
+        if (value)
+            _words.back() |= bit_word(1) << (_size % bits_per_word);
+        ++_size;
+    }
+
+    void pop_back() {
+        --_size;
+        if (_size % bits_per_word == 0)
+            _words.pop_back();
+        else
+            _clear_tail();
+    }
+
+    reference operator[]( size_type pos ) {
+        return reference(&_words[pos / bits_per_word], bit_word(1) << (pos % bits_per_word));
+    }
+    const_reference operator[]( size_type pos ) const { return _test(pos); }
+
+    reference at( size_type pos ) {
+        if (pos >= _size)
+            throw std::out_of_range("Index out of range");
+        return (*this)[pos];
+    }
+    const_reference at( size_type pos ) const {
+        if (pos >= _size)
+            throw std::out_of_range("Index out of range");
+        return _test(pos);
+    }
+
+    reference front() { return *begin(); }
+    const_reference front() const { return _test(0); }
+    reference back() { return *(end() - 1); }
+    const_reference back() const { return _test(_size - 1); }
+
+    iterator begin() { return iterator(_words.data(), 0); }
+    const_iterator begin() const { return const_iterator(_words.data(), 0); }
+    iterator end() { return begin() + _size; }
+    const_iterator end() const { return begin() + _size; }
+    reverse_iterator rbegin() { return reverse_iterator(end() - 1); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end() - 1); }
+    reverse_iterator rend() { return reverse_iterator(begin() - 1); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin() - 1); }
+
+    void clear() {
+        _words.clear();
+        _size = 0;
+    }
+
+    iterator insert( iterator pos, const bool& value ) {
+        size_type index = pos - begin();
+        insert(pos, 1, value);
+        return begin() + index;
+    }
+
+    void insert( iterator pos, size_type count, const bool& value ) {
+        size_type index = pos - begin();
+        _open_gap(index, count);
+        std::fill(begin() + index, begin() + index + count, value);
+    }
+
+    template< class InputIt >
+    typename enable_if<!is_integral<InputIt>::value, void >::type insert( iterator pos, InputIt first, InputIt last ) {
+        size_type index = pos - begin();
+        vector tmp(first, last);
+        _open_gap(index, tmp.size());
+        std::copy(tmp.begin(), tmp.end(), begin() + index);
+    }
+
+    iterator erase( iterator pos ) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase( iterator first, iterator last ) {
+        if (first >= last)
+            return last;
+        size_type index = first - begin();
+        std::copy(last, end(), first);
+        resize(_size - (last - first));
+        return begin() + index;
+    }
+
+    void swap( vector& other ) {
+        _words.swap(other._words);
+        std::swap(_size, other._size);
+    }
+
+    void flip() {
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] = ~_words[i];
+        _clear_tail();
+    }
+
+    // Number of set bits, one popcount per word.
+    size_type count() const {
+        size_type n = 0;
+        for (size_type i = 0; i < _words.size(); ++i)
+            n += __builtin_popcountl(_words[i]);
+        return n;
+    }
+
+    bool any() const {
+        for (size_type i = 0; i < _words.size(); ++i)
+            if (_words[i] != 0)
+                return true;
+        return false;
+    }
+
+    bool none() const { return !any(); }
+
+    // Index of the first set bit, or npos.
+    size_type find_first() const { return _scan(0); }
+
+    // Index of the first set bit after pos, or npos; also npos for
+    // pos == npos.
+    size_type find_next( size_type pos ) const {
+        if (pos >= _size || pos + 1 >= _size)
+            return npos;
+        ++pos;
+        size_type w = pos / bits_per_word;
+        bit_word rest = _words[w] & (~bit_word(0) << (pos % bits_per_word));
+        if (rest != 0)
+            return w * bits_per_word + __builtin_ctzl(rest);
+        return _scan(w + 1);
+    }
+
+    // Word-wise set operations; both vectors must have the same size.
+    vector& operator&=( const vector& other ) {
+        _check_size(other);
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] &= other._words[i];
+        return *this;
+    }
+
+    vector& operator|=( const vector& other ) {
+        _check_size(other);
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] |= other._words[i];
+        return *this;
+    }
+
+    vector& operator^=( const vector& other ) {
+        _check_size(other);
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] ^= other._words[i];
+        return *this;
+    }
+
+private:
+    ft::vector<bit_word, word_allocator_type, Growth> _words;
+    size_t _size;
+
+    static size_type _word_count( size_type bits ) { return (bits + bits_per_word - 1) / bits_per_word; }
+
+    bool _test( size_type pos ) const {
+        return (_words[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+    }
+
+    void _clear_tail() {
+        if (_size % bits_per_word != 0)
+            _words.back() &= ~(~bit_word(0) << (_size % bits_per_word));
+    }
+
+    size_type _scan( size_type w ) const {
+        for ( ; w < _words.size(); ++w)
+            if (_words[w] != 0)
+                return w * bits_per_word + __builtin_ctzl(_words[w]);
+        return npos;
+    }
+
+    void _check_size( const vector& other ) const {
+        if (other._size != _size)
+            throw std::invalid_argument("Size mismatch");
+    }
+
+    // Makes room for count bits at index, shifting the tail up.
+    void _open_gap( size_type index, size_type count ) {
+        if (count == 0)
+            return ;
+        size_type old_size = _size;
+        _words.resize(_word_count(old_size + count), 0);
+        _size = old_size + count;
+        std::copy_backward(begin() + index, begin() + old_size, end());
+    }
+};
+
+template< class Alloc, class Growth >
+const typename vector<bool, Alloc, Growth>::size_type vector<bool, Alloc, Growth>::npos;
+
+template< class Alloc, class Growth >
+bool operator==( const ft::vector<bool,Alloc,Growth>& lhs,
+                const ft::vector<bool,Alloc,Growth>& rhs ) {
+    return lhs.size() == rhs.size()
+            && ft::equal(lhs.word_data(), lhs.word_data() + lhs.word_count(), rhs.word_data());
+}
+
+template< class Alloc, class Growth >
+bool operator!=( const ft::vector<bool,Alloc,Growth>& lhs,
+                const ft::vector<bool,Alloc,Growth>& rhs ) { return !(lhs == rhs); }
+
+template< class Alloc, class Growth >
+ft::vector<bool,Alloc,Growth> operator&( const ft::vector<bool,Alloc,Growth>& lhs,
+                                         const ft::vector<bool,Alloc,Growth>& rhs ) {
+    ft::vector<bool,Alloc,Growth> tmp(lhs);
+    return tmp &= rhs;
+}
+
+template< class Alloc, class Growth >
+ft::vector<bool,Alloc,Growth> operator|( const ft::vector<bool,Alloc,Growth>& lhs,
+                                         const ft::vector<bool,Alloc,Growth>& rhs ) {
+    ft::vector<bool,Alloc,Growth> tmp(lhs);
+    return tmp |= rhs;
+}
+
+template< class Alloc, class Growth >
+ft::vector<bool,Alloc,Growth> operator^( const ft::vector<bool,Alloc,Growth>& lhs,
+                                         const ft::vector<bool,Alloc,Growth>& rhs ) {
+    ft::vector<bool,Alloc,Growth> tmp(lhs);
+    return tmp ^= rhs;
+}
+}
+
+#endif//FT_CONTAINERS_VECTOR_BOOL_HPP